@@ -0,0 +1,24 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "./cfg.h"
+
+/* Memory barrier for the lock-free rings (pool queue, stream ring)
+ *
+ * GCC-style `__atomic` builtins when available, otherwise an empty
+ * `NRF24L01_CRITICAL_ENTER()`/`NRF24L01_CRITICAL_EXIT()` pair.
+ */
+#if defined(NRF24L01_CRITICAL_ENTER) && defined(NRF24L01_CRITICAL_EXIT)
+#define NRF24_BARRIER() do { NRF24L01_CRITICAL_ENTER(); NRF24L01_CRITICAL_EXIT(); } while (0)
+#elif defined(__GNUC__)
+#define NRF24_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#error "Lock-free rings need GCC-style atomics or NRF24L01_CRITICAL_ENTER/EXIT"
+#endif
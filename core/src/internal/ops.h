@@ -11,6 +11,73 @@
 #include "nrf24l01_dep.h"
 #include "nrf24l01_reg.h"
 
+#ifdef NRF24L01_ENABLE_TRACE
+
+#ifndef NRF24L01_TRACE_TIMESTAMP
+#error "Missing NRF24L01_TRACE_TIMESTAMP definition (e.g. a free-running us/cycle counter)"
+#endif
+
+/**
+ * @brief Append a transaction record to the attached trace buffer.
+ *
+ * Kept branch-light on purpose: one NULL check, one masked store and a
+ * bounded copy of the first data bytes.
+ */
+static inline void trace_rec(nrf24_dep_t *dep, uint8_t cmd, const uint8_t *data, uint8_t len, uint8_t flags)
+{
+    nrf24_trace_t *t = dep->trace;
+    nrf24_trace_rec_t *r;
+    uint8_t n;
+
+    if (t == 0) {
+        return;
+    }
+
+    if (cmd == (NRF24_CMD_R_REG | NRF24_REG_STATUS) && len != 0) {
+        t->status = data[0];
+    }
+
+    r = &t->recs[t->seq++ & t->mask];
+    r->ts = NRF24L01_TRACE_TIMESTAMP();
+    r->cmd = cmd;
+    r->len = len;
+    r->status = t->status;
+    r->flags = flags;
+
+    n = len < NRF24_TRACE_DATA_MAX ? len : NRF24_TRACE_DATA_MAX;
+    for (uint8_t i = 0; i < n; i++) {
+        r->data[i] = data[i];
+    }
+}
+
+#define TRACE_REC(dep, cmd, data, len, ret, flags) \
+    trace_rec(dep, cmd, data, len, (flags) | ((ret) != 0 ? NRF24_TRACE_FLAG_ERR : 0))
+#else
+#define TRACE_REC(dep, cmd, data, len, ret, flags)
+#endif // NRF24L01_ENABLE_TRACE
+
+#ifdef NRF24L01_ENABLE_LOCK
+static inline void dep_lock(nrf24_dep_t *dep)
+{
+    if (dep->ops->lock != 0) {
+        dep->ops->lock(dep->ctx);
+    }
+}
+
+static inline void dep_unlock(nrf24_dep_t *dep)
+{
+    if (dep->ops->unlock != 0) {
+        dep->ops->unlock(dep->ctx);
+    }
+}
+
+#define DEP_LOCK(dep) dep_lock(dep)
+#define DEP_UNLOCK(dep) dep_unlock(dep)
+#else
+#define DEP_LOCK(dep)
+#define DEP_UNLOCK(dep)
+#endif // NRF24L01_ENABLE_LOCK
+
 static inline int dep_init(nrf24_dep_t *dep) 
 {
     if (dep->ops->init != 0) {
@@ -32,102 +99,143 @@ static inline void set_ce(nrf24_dep_t *dep, char val)
         dep->ops->set_ce_high(dep->ctx);
     else
         dep->ops->set_ce_low(dep->ctx);
+
+    TRACE_REC(dep, val ? NRF24_TRACE_CMD_CE_HIGH : NRF24_TRACE_CMD_CE_LOW, 0, 0, 0, 0);
 }
 
 static inline int read_reg(nrf24_dep_t *dep, uint8_t reg, uint8_t *val) 
 {
+    int ret;
     uint8_t cmd;
 
     cmd = NRF24_CMD_R_REG | reg;
-    return dep->ops->spi_send_then_recv(dep->ctx, &cmd, 1, val, 1);
+    ret = dep->ops->spi_send_then_recv(dep->ctx, &cmd, 1, val, 1);
+    TRACE_REC(dep, cmd, val, 1, ret, NRF24_TRACE_FLAG_READ);
+    return ret;
 }
 
 static inline int write_reg(nrf24_dep_t *dep, uint8_t reg, uint8_t val) 
 {
+    int ret;
     uint8_t buf[2];
     buf[0] = NRF24_CMD_W_REG | reg;
     buf[1] = val;
-    return dep->ops->spi_send(dep->ctx, buf, 2);
+    ret = dep->ops->spi_send(dep->ctx, buf, 2);
+    TRACE_REC(dep, buf[0], &buf[1], 1, ret, 0);
+    return ret;
 }
 
 static inline int read_regs(nrf24_dep_t *dep, uint8_t reg, uint8_t *val, uint8_t len) 
 {
+    int ret;
     uint8_t cmd;
     cmd = NRF24_CMD_R_REG | reg;
-    return dep->ops->spi_send_then_recv(dep->ctx, &cmd, 1, val, len);
+    ret = dep->ops->spi_send_then_recv(dep->ctx, &cmd, 1, val, len);
+    TRACE_REC(dep, cmd, val, len, ret, NRF24_TRACE_FLAG_READ);
+    return ret;
 }
 
 static inline int write_regs(nrf24_dep_t *dep, uint8_t reg, const uint8_t *val, uint8_t len) 
 {
+    int ret;
     uint8_t cmd;
     cmd = NRF24_CMD_W_REG | reg;
-    return dep->ops->spi_send_then_send(dep->ctx, &cmd, 1, val, len);
+    ret = dep->ops->spi_send_then_send(dep->ctx, &cmd, 1, val, len);
+    TRACE_REC(dep, cmd, val, len, ret, 0);
+    return ret;
 }
 
 static inline int send_cmd_read_rx_payload(nrf24_dep_t *dep, uint8_t *buf, uint8_t len)
 {
+    int ret;
     uint8_t cmd;
     cmd = NRF24_CMD_R_RX_PAYLOAD;
-    return dep->ops->spi_send_then_recv(dep->ctx, &cmd, 1, buf, len);
+    ret = dep->ops->spi_send_then_recv(dep->ctx, &cmd, 1, buf, len);
+    TRACE_REC(dep, cmd, buf, len, ret, NRF24_TRACE_FLAG_READ);
+    return ret;
 }
 
 static inline int send_cmd_write_tx_payload(nrf24_dep_t *dep, const uint8_t *buf, uint8_t len)
 {
+    int ret;
     uint8_t cmd;
     cmd = NRF24_CMD_W_TX_PAYLOAD;
-    return dep->ops->spi_send_then_send(dep->ctx, &cmd, 1, buf, len);
+    ret = dep->ops->spi_send_then_send(dep->ctx, &cmd, 1, buf, len);
+    TRACE_REC(dep, cmd, buf, len, ret, 0);
+    return ret;
 }
 
 
 static inline int send_cmd_flush_tx(nrf24_dep_t *dep)
 {
+    int ret;
     uint8_t cmd;
     cmd = NRF24_CMD_FLUSH_TX;
-    return dep->ops->spi_send(dep->ctx, &cmd, 1);
+    ret = dep->ops->spi_send(dep->ctx, &cmd, 1);
+    TRACE_REC(dep, cmd, 0, 0, ret, 0);
+    return ret;
 }
 
 static inline int send_cmd_flush_rx(nrf24_dep_t *dep)
 {
+    int ret;
     uint8_t cmd;
     cmd = NRF24_CMD_FLUSH_RX;
-    return dep->ops->spi_send(dep->ctx, &cmd, 1);
+    ret = dep->ops->spi_send(dep->ctx, &cmd, 1);
+    TRACE_REC(dep, cmd, 0, 0, ret, 0);
+    return ret;
 }
 
 static inline int send_cmd_reuse_tx_payload(nrf24_dep_t *dep)
 {
+    int ret;
     uint8_t cmd;
     cmd = NRF24_CMD_REUSE_TX_PL;
-    return dep->ops->spi_send(dep->ctx, &cmd, 1);
+    ret = dep->ops->spi_send(dep->ctx, &cmd, 1);
+    TRACE_REC(dep, cmd, 0, 0, ret, 0);
+    return ret;
 }
 
 static inline int send_cmd_activate(nrf24_dep_t *dep)
 {
+    int ret;
     uint8_t buf[2];
     buf[0] = NRF24_CMD_ACTIVATE;
     buf[1] = 0x73;
-    return dep->ops->spi_send(dep->ctx, buf, 2);
+    ret = dep->ops->spi_send(dep->ctx, buf, 2);
+    TRACE_REC(dep, buf[0], &buf[1], 1, ret, 0);
+    return ret;
 }
 
 static inline int send_cmd_read_rx_payload_width(nrf24_dep_t *dep)
 {
+    int ret;
     uint8_t cmd;
     uint8_t val;
 
     cmd = NRF24_CMD_R_RX_PL_WID;
-    dep->ops->spi_send_then_recv(dep->ctx, &cmd, 1, &val, 1);
+    ret = dep->ops->spi_send_then_recv(dep->ctx, &cmd, 1, &val, 1);
+    TRACE_REC(dep, cmd, &val, 1, ret, NRF24_TRACE_FLAG_READ);
+    (void)ret;
     return val;
 }
 
 static inline int send_cmd_write_ack_payload(nrf24_dep_t *dep, uint8_t pipe, const uint8_t *data, uint8_t len)
 {
+    int ret;
     uint8_t cmd;
     cmd = NRF24_CMD_W_ACK_PAYLOAD | pipe;
-    return dep->ops->spi_send_then_send(dep->ctx, &cmd, 1, data, len);
+    ret = dep->ops->spi_send_then_send(dep->ctx, &cmd, 1, data, len);
+    TRACE_REC(dep, cmd, data, len, ret, 0);
+    return ret;
 }
 
 static inline int send_cmd_write_tx_payload_no_ack(nrf24_dep_t *dep, const uint8_t *data, uint8_t len) 
 {
+    int ret;
     uint8_t cmd;
     cmd = NRF24_CMD_W_TX_PAYLOAD_NO_ACK;
-    return dep->ops->spi_send_then_send(dep->ctx, &cmd, 1, data, len);   
+    ret = dep->ops->spi_send_then_send(dep->ctx, &cmd, 1, data, len);
+    TRACE_REC(dep, cmd, data, len, ret, 0);
+    return ret;
 }
@@ -15,12 +15,17 @@
 #include "./internal/ops.h"
 #include "./internal/cfg.h"
 #include "./internal/log.h"
+#include "nrf24l01_regimage.h"
 
 #ifdef CHECK
 #undef CHECK
 #endif
 #define CHECK NRF24_CHECK
 
+/* Guard a multi-transaction operation (see `NRF24L01_ENABLE_LOCK`) */
+#define LOCK(nrf24) DEP_LOCK(&(nrf24)->dep)
+#define UNLOCK(nrf24) DEP_UNLOCK(&(nrf24)->dep)
+
 /* return value to readable string */
 #define R2S(r) (r == 0 ? "ok" : "fail")
 
@@ -31,8 +36,14 @@
 
 #include "./snippets/nrf24l01/reg.inc.c"
 #include "./snippets/nrf24l01/mem.inc.c"
+#include "./snippets/nrf24l01/regfile.inc.c"
+#include "./snippets/nrf24l01/cfgtxn.inc.c"
 #include "./snippets/nrf24l01/usercfg.inc.c"
 #include "./snippets/nrf24l01/fifo.inc.c"
+#include "./snippets/nrf24l01/dest.inc.c"
+#include "./snippets/nrf24l01/power.inc.c"
+#include "./snippets/nrf24l01/trace.inc.c"
+#include "./snippets/nrf24l01/timestamp.inc.c"
 
 uint8_t nrf24_read_reg(nrf24_t *nrf24, uint8_t reg)
 {
@@ -43,12 +54,22 @@ uint8_t nrf24_read_reg(nrf24_t *nrf24, uint8_t reg)
 
 int nrf24_write_reg(nrf24_t *nrf24, uint8_t reg, uint8_t val)
 {
-    return write_reg(&nrf24->dep, reg, val);
+    int ret;
+    LOCK(nrf24);
+    shadow_note_write(nrf24, reg, &val, 1);
+    ret = write_reg(&nrf24->dep, reg, val);
+    UNLOCK(nrf24);
+    return ret;
 }
 
 int nrf24_write_regs(nrf24_t *nrf24, uint8_t reg, uint8_t *vals, uint8_t len)
 {
-    return write_regs(&nrf24->dep, reg, vals, len);
+    int ret;
+    LOCK(nrf24);
+    shadow_note_write(nrf24, reg, vals, len);
+    ret = write_regs(&nrf24->dep, reg, vals, len);
+    UNLOCK(nrf24);
+    return ret;
 }
 
 int nrf24_read_regs(nrf24_t *nrf24, uint8_t reg, uint8_t *vals, uint8_t len)
@@ -72,24 +93,34 @@ nrf24_observe_t nrf24_read_observe(nrf24_t *nrf24)
 
 void nrf24_power_up(nrf24_t *nrf24)
 {
-    reg_modify_bits(&nrf24->dep, NRF24_REG_CONFIG, REG_CONFIG_BITMASK_PWR_UP, 1);
+    LOCK(nrf24);
+    shadow_modify_bits(nrf24, NRF24_REG_CONFIG, REG_CONFIG_BITMASK_PWR_UP, 1);
+    nrf24->pwr.is_pwr_up = 1;
+    pwr_sync(nrf24);
+    UNLOCK(nrf24);
 }
 
 void nrf24_power_down(nrf24_t *nrf24)
 {
-    reg_modify_bits(&nrf24->dep, NRF24_REG_CONFIG, REG_CONFIG_BITMASK_PWR_UP, 0);
+    LOCK(nrf24);
+    shadow_modify_bits(nrf24, NRF24_REG_CONFIG, REG_CONFIG_BITMASK_PWR_UP, 0);
+    nrf24->pwr.is_pwr_up = 0;
+    pwr_sync(nrf24);
+    UNLOCK(nrf24);
 }
 
 void nrf24_radio_on(nrf24_t *nrf24)
 {
     set_ce(&nrf24->dep, 1);
     nrf24->is_radio_on = 1;
+    pwr_sync(nrf24);
 }
 
 void nrf24_radio_off(nrf24_t *nrf24)
 {
     set_ce(&nrf24->dep, 0);
     nrf24->is_radio_on = 0;
+    pwr_sync(nrf24);
 }
 
 /**
@@ -104,6 +135,7 @@ uint8_t nrf24_read_status(nrf24_t *nrf24)
 {
     uint8_t sta;
     read_reg(&nrf24->dep, NRF24_REG_STATUS, &sta);
+    ts_capture(nrf24, sta);
     return sta;
 }
 
@@ -120,6 +152,7 @@ void nrf24_clear_status(nrf24_t *nrf24, uint8_t sta)
     if ((sta & (REG_STATUS_BITMASK_RX_DR | REG_STATUS_BITMASK_TX_DS))) {
         // clear status (not including MAX_RT)
         write_reg(&nrf24->dep, NRF24_REG_STATUS, sta & ~REG_STATUS_BITMASK_MAX_RT); 
+        ts_release(nrf24, sta & ~REG_STATUS_BITMASK_MAX_RT);
     }
 }
 
@@ -133,8 +166,11 @@ void nrf24_clear_status(nrf24_t *nrf24, uint8_t sta)
  */
 uint8_t nrf24_read_and_clear_status(nrf24_t *nrf24)
 {
-    uint8_t sta = nrf24_read_status(nrf24);
+    uint8_t sta;
+    LOCK(nrf24);
+    sta = nrf24_read_status(nrf24);
     nrf24_clear_status(nrf24, sta);
+    UNLOCK(nrf24);
     return sta;
 }
 
@@ -144,13 +180,16 @@ uint8_t nrf24_read_and_clear_status(nrf24_t *nrf24)
 void nrf24_clear_all_status(nrf24_t *nrf24)
 {
     uint8_t tmp;
+    LOCK(nrf24);
     // clear status flags
     read_reg(&nrf24->dep, NRF24_REG_STATUS, &tmp);
     write_reg(&nrf24->dep, NRF24_REG_STATUS, tmp);
+    ts_release(nrf24, tmp);
 
     // clear plos_cnt
     read_reg(&nrf24->dep, NRF24_REG_RF_CH, &tmp);
     write_reg(&nrf24->dep, NRF24_REG_RF_CH, tmp);
+    UNLOCK(nrf24);
 }
 
 /**
@@ -159,6 +198,7 @@ void nrf24_clear_all_status(nrf24_t *nrf24)
 void nrf24_clear_txfail_flag(nrf24_t *nrf24)
 {
     write_reg(&nrf24->dep, NRF24_REG_STATUS, REG_STATUS_BITMASK_MAX_RT);
+    ts_release(nrf24, REG_STATUS_BITMASK_MAX_RT);
 }
 
 /**
@@ -166,16 +206,20 @@ void nrf24_clear_txfail_flag(nrf24_t *nrf24)
  */
 void nrf24_clear_all_fifo(nrf24_t *nrf24)
 {
+    LOCK(nrf24);
     send_cmd_flush_tx(&nrf24->dep);
     send_cmd_flush_rx(&nrf24->dep);
+    UNLOCK(nrf24);
 }
 
 /**
  * @brief Clear all status and data
  */
 void nrf24_clear_all(nrf24_t *nrf24) {
+    LOCK(nrf24);
     nrf24_clear_all_fifo(nrf24);
     nrf24_clear_all_status(nrf24);
+    UNLOCK(nrf24);
 }
 
 static inline int is_valid_pipeno(uint8_t pipeno)
@@ -190,15 +234,18 @@ static inline int is_valid_pipeno(uint8_t pipeno)
  */
 int nrf24_role_switch(nrf24_t *nrf24, nrf24_role_enum_t role)
 {
-    if (nrf24->role == role) {
-        return 0;
-    }
-
-    nrf24->role = role;
+    int ret = 0;
 
-    nrf24_clear_all(nrf24);
+    LOCK(nrf24);
+    if (nrf24->role != role) {
+        nrf24->role = role;
+        nrf24_clear_all(nrf24);
+        ret = shadow_modify_bits(nrf24, NRF24_REG_CONFIG, REG_CONFIG_BITMASK_PRIM_RX, role);
+        pwr_sync(nrf24);
+    }
+    UNLOCK(nrf24);
 
-    return reg_modify_bits(&nrf24->dep, NRF24_REG_CONFIG, REG_CONFIG_BITMASK_PRIM_RX, role);
+    return ret;
 }
 
 /**
@@ -208,13 +255,17 @@ int nrf24_role_switch(nrf24_t *nrf24, nrf24_role_enum_t role)
  */
 int nrf24_role_switch_directly(nrf24_t *nrf24, nrf24_role_enum_t role)
 {
-    if (nrf24->role == role) {
-        return 0;
-    }
+    int ret = 0;
 
-    nrf24->role = role;
+    LOCK(nrf24);
+    if (nrf24->role != role) {
+        nrf24->role = role;
+        ret = shadow_modify_bits(nrf24, NRF24_REG_CONFIG, REG_CONFIG_BITMASK_PRIM_RX, role);
+        pwr_sync(nrf24);
+    }
+    UNLOCK(nrf24);
 
-    return reg_modify_bits(&nrf24->dep, NRF24_REG_CONFIG, REG_CONFIG_BITMASK_PRIM_RX, role);
+    return ret;
 }
 
 /// @return return `true` if is ROLE PRX
@@ -244,27 +295,36 @@ int nrf24_check_device(nrf24_t *nrf24)
     uint8_t cmd;
     uint8_t addr_backup[5];
     uint8_t addr[5];
+    uint8_t setupaw = 0;
+    uint8_t aw;
     LOG_V("enter %s", __func__);
 
+    LOCK(nrf24);
+
+    /* Addresses are as wide as the device is currently configured for */
+    read_reg(&nrf24->dep, NRF24_REG_SETUP_AW, &setupaw);
+    aw = aw_bytes(setupaw);
+
     /* Backup the rx address */
-    read_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, addr_backup, 5);
+    clear_object(addr_backup, sizeof(addr_backup));
+    read_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, addr_backup, aw);
 
     /* Set new rx address */
     for (int i = 0; i < 5; i++) {
         addr[i] = addr_backup[i] + i;
     }
-    write_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, addr, 5);
+    write_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, addr, aw);
     LOG_V("set rx address: %02x %02x %02x %02x %02x", addr[0], addr[1], addr[2], addr[3], addr[4]);
 
     /* Get and verify the rx address */
     for (int i = 0; i < 5; i++) {
         addr[i] = 0;
     }
-    read_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, addr, 5);
+    read_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, addr, aw);
     LOG_V("got rx address: %02x %02x %02x %02x %02x", addr[0], addr[1], addr[2], addr[3], addr[4]);
 
-    for (int i = 0; i < 5; i++) {
-        if (addr[i] != addr_backup[i] + i) {
+    for (int i = 0; i < aw; i++) {
+        if (addr[i] != (uint8_t)(addr_backup[i] + i)) {
             ret = -1;
             break;
         }
@@ -272,7 +332,9 @@ int nrf24_check_device(nrf24_t *nrf24)
 
     /* Restore the rx address */
     LOG_V("restore backup rx address: %02x %02x %02x %02x %02x", addr_backup[0], addr_backup[1], addr_backup[2], addr_backup[3], addr_backup[4]);
-    write_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, addr_backup, 5);
+    write_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, addr_backup, aw);
+
+    UNLOCK(nrf24);
 
     LOG_V("exit %s [%s]", __func__, R2S(ret));
     return ret;
@@ -319,33 +381,23 @@ nrf24_status_enum_t nrf24_status_routine(nrf24_t *nrf24, uint8_t sta)
 
 
 
-/* Configuration:
- *  - PTX mode
- *  - Power down
- *  - channel 2
- *  - 2 bytes crc
- *  - 5 bytes address width
- *  - all pipes feature (auto-ack,..) enabled
- *  - 9 times (max) retransmit && 750us delay
- *  - all irq source enabled
- *  - all features enabled
- * 
- * Note: Gen by utils/regscfg
- */
-nrf24_regval_t nrf24_default_regval_list[] = {
-    {NRF24_REG_CONFIG, 0x0c},
-    {NRF24_REG_EN_AA, 0x3f},
-    {NRF24_REG_EN_RXADDR, 0x01},
-    {NRF24_REG_SETUP_AW, 0x03},
-    {NRF24_REG_SETUP_RETR, 0x29},
-    {NRF24_REG_RF_CH, 0x02},
-    {NRF24_REG_RF_SETUP, 0x0f},
-    {NRF24_REG_RX_ADDR_P2, 0xc3},
-    {NRF24_REG_RX_ADDR_P3, 0xc4},
-    {NRF24_REG_RX_ADDR_P4, 0xc5},
-    {NRF24_REG_RX_ADDR_P5, 0xc6},
-    {NRF24_REG_DYNPD, 0x3f},
-    {NRF24_REG_FEATURE, 0x07},
+/* Default configuration, see `nrf24l01_regimage.h` (Gen by utils/regscfg) */
+const uint8_t nrf24_default_regimage[] = NRF24_REGIMAGE_INITIALIZER;
+
+const nrf24_regval_t nrf24_default_regval_list[] = {
+    {NRF24_REG_CONFIG, NRF24_REGIMAGE_CONFIG},
+    {NRF24_REG_EN_AA, NRF24_REGIMAGE_EN_AA},
+    {NRF24_REG_EN_RXADDR, NRF24_REGIMAGE_EN_RXADDR},
+    {NRF24_REG_SETUP_AW, NRF24_REGIMAGE_SETUP_AW},
+    {NRF24_REG_SETUP_RETR, NRF24_REGIMAGE_SETUP_RETR},
+    {NRF24_REG_RF_CH, NRF24_REGIMAGE_RF_CH},
+    {NRF24_REG_RF_SETUP, NRF24_REGIMAGE_RF_SETUP},
+    {NRF24_REG_RX_ADDR_P2, NRF24_REGIMAGE_RX_ADDR_P2},
+    {NRF24_REG_RX_ADDR_P3, NRF24_REGIMAGE_RX_ADDR_P3},
+    {NRF24_REG_RX_ADDR_P4, NRF24_REGIMAGE_RX_ADDR_P4},
+    {NRF24_REG_RX_ADDR_P5, NRF24_REGIMAGE_RX_ADDR_P5},
+    {NRF24_REG_DYNPD, NRF24_REGIMAGE_DYNPD},
+    {NRF24_REG_FEATURE, NRF24_REGIMAGE_FEATURE},
 };
 
 const int nrf24_default_regval_list_num  = sizeof(nrf24_default_regval_list)/sizeof(nrf24_default_regval_list[0]);
@@ -354,13 +406,69 @@ int nrf24_write_reg_list(nrf24_t *nrf24, const nrf24_regval_t *regvals, int num)
 {
     int ret = 0;
 
+    LOCK(nrf24);
     for (int i = 0; i < num; i++) {
         ret += nrf24_write_reg(nrf24, regvals[i].reg, regvals[i].val);
     }
+    UNLOCK(nrf24);
 
     return ret;
 }
 
+/**
+ * @brief Write a register image (runs of `{first_reg, num_regs, val...}` terminated by NRF24_REGIMAGE_END).
+ *
+ * @note The device does not auto-increment register addresses, so each register
+ *       still takes one transaction; the run layout only keeps the image compact.
+ */
+int nrf24_write_reg_image(nrf24_t *nrf24, const uint8_t *image)
+{
+    int ret = 0;
+
+    LOCK(nrf24);
+
+    if (nrf24->is_shadow_valid) {
+        regfile_load_image(&nrf24->shadow, image);
+    }
+
+    while (image[0] != NRF24_REGIMAGE_END) {
+        uint8_t reg = image[0];
+        uint8_t num = image[1];
+
+        for (uint8_t i = 0; i < num; i++) {
+            ret += write_reg(&nrf24->dep, reg + i, image[2 + i]);
+        }
+
+        image += 2 + num;
+    }
+
+    UNLOCK(nrf24);
+
+    return ret;
+}
+
+/**
+ * @brief Look up a register value in a register image.
+ *
+ * @return 0 if found, -1 otherwise.
+ */
+int nrf24_reg_image_lookup(const uint8_t *image, uint8_t reg, uint8_t *val)
+{
+    while (image[0] != NRF24_REGIMAGE_END) {
+        uint8_t first = image[0];
+        uint8_t num = image[1];
+
+        if (reg >= first && reg < first + num) {
+            *val = image[2 + reg - first];
+            return 0;
+        }
+
+        image += 2 + num;
+    }
+
+    return -1;
+}
+
 /**
  * @brief Configure and bring up the NRF24 device.
  *
@@ -378,7 +486,160 @@ int nrf24_setup(nrf24_t *nrf24, nrf24_role_enum_t role)
     nrf24_user_cfg_t ucfg;
     nrf24_usercfg_init_default(&ucfg);
 
-    return nrf24_setup_full(nrf24, role, &ucfg, nrf24_default_regval_list, sizeof(nrf24_default_regval_list)/sizeof(nrf24_default_regval_list[0])); 
+    return nrf24_setup_image(nrf24, role, &ucfg, nrf24_default_regimage); 
+}
+
+/**
+ * @brief Configure and bring up the NRF24 device from a register image.
+ *
+ * Same as `nrf24_setup_full()`, but the role and power-up bits are folded into
+ * the final CONFIG write instead of separate read-modify-write cycles.
+ *
+ * @param nrf24  Pointer to the NRF24 device instance.
+ * @param role   Initial role of the device (NRF24_ROLE_PRX or NRF24_ROLE_PTX).
+ * @param ucfg   User config.
+ * @param image  Register image (e.g. `nrf24_default_regimage`), must contain CONFIG.
+ * @return       0 on success, non-zero on error.
+ */
+int nrf24_setup_image(nrf24_t *nrf24, nrf24_role_enum_t role, const nrf24_user_cfg_t *ucfg, const uint8_t *image)
+{
+    int ret = 0;
+    uint8_t config;
+    LOG_V("enter %s", __func__);
+    
+    CHECK(nrf24 != 0);
+    CHECK(nrf24_reg_image_lookup(image, NRF24_REG_CONFIG, &config) == 0);
+
+    LOCK(nrf24);
+
+    nrf24->role = role;
+    nrf24->is_shadow_valid = 0;
+
+    /* Check connection */
+    ret = nrf24_check_device(nrf24);
+    if (ret != 0) {
+        LOG_E("check device failed");
+        goto __nsi_exit;
+    }
+    LOG_D("check device success");
+
+    /* Do soft reset (the image powers the device down first) */
+    nrf24_radio_off(nrf24);
+    ret += nrf24_write_reg_image(nrf24, image);
+    nrf24_clear_all_fifo(nrf24);
+    ret += write_reg(&nrf24->dep, NRF24_REG_STATUS, REG_STATUS_BITMASK_RX_DR | REG_STATUS_BITMASK_TX_DS | REG_STATUS_BITMASK_MAX_RT);
+
+    /* Do config */
+    ret += nrf24_usercfg_write_directly(nrf24, ucfg);
+
+    /* Set CRC, role and enable */
+    byte_set_bits(&config, CONFIG_BITMASK_CRC, crc_bits(ucfg->crc));
+    byte_set_bits(&config, REG_CONFIG_BITMASK_PRIM_RX, role);
+    config |= REG_CONFIG_BITMASK_PWR_UP;
+    ret += write_reg(&nrf24->dep, NRF24_REG_CONFIG, config);
+    nrf24->pwr.is_pwr_up = 1;
+    nrf24_radio_on(nrf24);
+
+    /* Cache what was written */
+    clear_object(&nrf24->shadow, sizeof(nrf24->shadow));
+    regfile_load_image(&nrf24->shadow, image);
+    regfile_apply_usercfg(&nrf24->shadow, ucfg);
+    nrf24->shadow.regs[NRF24_REG_CONFIG] = config;
+    nrf24->is_shadow_valid = ret == 0;
+
+__nsi_exit:
+    UNLOCK(nrf24);
+
+    if (ret) {
+        LOG_E("Device setup [fail]");
+    }else {
+        LOG_I("Device setup [ok]");
+    }
+
+    LOG_V("exit %s [%s]", __func__, R2S(ret));
+    return ret;
+}
+
+/**
+ * @brief Fast (warm) bring up: only write the registers that differ.
+ *
+ * Reads the configuration registers back, compares them with the intended
+ * configuration (image + user config + role + power-up) and writes only the
+ * differing ones. There is no device check and no soft reset, so on a warm
+ * restart where the device kept its configuration this costs about half the
+ * SPI transactions of `nrf24_setup_image()` and writes nothing.
+ *
+ * Falls back to `nrf24_setup_image()` when the read-back does not look like a
+ * device configured for this setup (e.g. no device, a power-on-reset one, or
+ * a different channel/data rate/CRC): CONFIG (role and power bits aside),
+ * RF_CH, RF_SETUP, SETUP_AW and FEATURE must already match.
+ *
+ * @param nrf24  Pointer to the NRF24 device instance.
+ * @param role   Role of the device (NRF24_ROLE_PRX or NRF24_ROLE_PTX).
+ * @param ucfg   User config.
+ * @param image  Register image (e.g. `nrf24_default_regimage`).
+ * @return       0 on success, non-zero on error.
+ *
+ * @note FIFO contents are kept, only a pending MAX_RT (stuck TX FIFO) is flushed.
+ * @attention If the device was powered down, wait Tpd2stby (1.5ms) before expecting TX/RX.
+ */
+int nrf24_setup_fast(nrf24_t *nrf24, nrf24_role_enum_t role, const nrf24_user_cfg_t *ucfg, const uint8_t *image)
+{
+    int ret = 0;
+    int nwritten = 0;
+    uint8_t sta = 0;
+    nrf24_regfile_t cur;
+    nrf24_regfile_t want;
+    LOG_V("enter %s", __func__);
+
+    CHECK(nrf24 != 0);
+
+    /* Intended configuration */
+    clear_object(&want, sizeof(want));
+    regfile_load_image(&want, image);
+    regfile_apply_usercfg(&want, ucfg);
+    byte_set_bits(&want.regs[NRF24_REG_CONFIG], REG_CONFIG_BITMASK_PRIM_RX, role);
+    want.regs[NRF24_REG_CONFIG] |= REG_CONFIG_BITMASK_PWR_UP;
+
+    LOCK(nrf24);
+
+    /* Current configuration */
+    ret = regfile_read(&nrf24->dep, &cur);
+    if (ret != 0 || !regfile_is_warm(&cur, &want)) {
+        /* no device, power-on-reset or foreign configuration */
+        LOG_D("fast setup not applicable, do full setup");
+        ret = nrf24_setup_image(nrf24, role, ucfg, image);
+        UNLOCK(nrf24);
+        return ret;
+    }
+
+    nrf24->role = role;
+
+    /* Recover from a pending MAX_RT */
+    ret += read_reg(&nrf24->dep, NRF24_REG_STATUS, &sta);
+    if (ret == 0 && (sta & REG_STATUS_BITMASK_MAX_RT)) {
+        send_cmd_flush_tx(&nrf24->dep);
+        ret += write_reg(&nrf24->dep, NRF24_REG_STATUS, REG_STATUS_BITMASK_MAX_RT);
+    }
+
+    nrf24_radio_off(nrf24);
+    ret += regfile_write_diff(&nrf24->dep, &cur, &want, &nwritten);
+    nrf24->pwr.is_pwr_up = 1;
+    nrf24_radio_on(nrf24);
+
+    copy(&nrf24->shadow, &want, sizeof(want));
+    nrf24->is_shadow_valid = ret == 0;
+
+    UNLOCK(nrf24);
+
+    if (ret) {
+        LOG_E("Device setup (fast) [fail]");
+    }else {
+        LOG_I("Device setup (fast) [ok] (%d registers rewritten)", nwritten);
+    }
+
+    LOG_V("exit %s [%s]", __func__, R2S(ret));
+    return ret;
 }
 
 int nrf24_setup_full(nrf24_t *nrf24, nrf24_role_enum_t role, const nrf24_user_cfg_t *ucfg, const nrf24_regval_t *regvals, int regvals_num)
@@ -388,8 +649,11 @@ int nrf24_setup_full(nrf24_t *nrf24, nrf24_role_enum_t role, const nrf24_user_cf
     
     CHECK(nrf24 != 0);
 
+    LOCK(nrf24);
+
     /* */
     nrf24->role = role;
+    nrf24->is_shadow_valid = 0;
 
     /* Check connection */
     ret = nrf24_check_device(nrf24);
@@ -413,13 +677,15 @@ int nrf24_setup_full(nrf24_t *nrf24, nrf24_role_enum_t role, const nrf24_user_cf
     nrf24_usercfg_write_directly(nrf24, ucfg);
 
     /* Set role */
-    reg_modify_bits(&nrf24->dep, NRF24_REG_CONFIG, REG_CONFIG_BITMASK_PRIM_RX, role);
+    shadow_modify_bits(nrf24, NRF24_REG_CONFIG, REG_CONFIG_BITMASK_PRIM_RX, role);
 
     /* Enable */
     nrf24_power_up(nrf24);
     nrf24_radio_on(nrf24);
 
 __ns_exit:
+    UNLOCK(nrf24);
+
     if (ret) {
         LOG_E("Device setup [fail]");
     }else {
@@ -455,6 +721,14 @@ int nrf24_init(nrf24_t *nrf24, nrf24_dep_ops_t *ops, void *ops_ctx)
 
     /* Initialize attributes */
     nrf24->ack_pipe = 0;
+    nrf24->is_shadow_valid = 0;
+    clear_object(&nrf24->pwr, sizeof(nrf24->pwr));
+#ifdef NRF24L01_ENABLE_TIMESTAMP
+    clear_object(&nrf24->ts, sizeof(nrf24->ts));
+#endif
+#ifdef NRF24L01_ENABLE_TRACE
+    nrf24->dep.trace = 0;
+#endif
 
     /* Initialize dep */
     nrf24->dep.ops = ops;
@@ -28,6 +28,9 @@ typedef enum {
     NRF24_STA_TX_RX_OK    = NRF24_STA_TX_SENT | NRF24_STA_HAS_RXDATA,
 } nrf24_status_enum_t;
 
+/* Error codes (besides -1: I/O or generic failure, -128: invalid argument) */
+#define NRF24_ERR_BUSY (-2) // resource in use, retry later
+
 typedef enum {
     NRF24_ROLE_PTX = 0,
     NRF24_ROLE_PRX = 1,
@@ -46,6 +49,20 @@ typedef enum
     NRF24_RF_POWER_0dBm   = 0x3,
 } nrf24_rfpower_enum_t;
 
+/* Address width (SETUP_AW encoding; 0, e.g. a zero-initialized config, means 5 bytes) */
+typedef enum {
+    NRF24_AW_3BYTES = 1,
+    NRF24_AW_4BYTES = 2,
+    NRF24_AW_5BYTES = 3,
+} nrf24_aw_enum_t;
+
+/* CRC length, forced on by auto-ack (0, e.g. a zero-initialized config, is the default 2 bytes) */
+typedef enum {
+    NRF24_CRC_2BYTES = 0,
+    NRF24_CRC_1BYTE = 1,
+    NRF24_CRC_OFF = 2,
+} nrf24_crc_enum_t;
+
 typedef struct {
     // RX FIFO empty flag 
     uint8_t rx_empty   : 1;  
@@ -91,12 +108,67 @@ typedef struct {
     // rf channel (0 ~ 125)
     uint8_t rf_channel;
 
+    // address width, addresses use their first 3-5 bytes
+    nrf24_aw_enum_t addr_width;
+
+    // crc length
+    nrf24_crc_enum_t crc;
+
     // tx addr
     uint8_t tx_addr[5];
 
     nrf24_rxpipe_cfg_t rxpipes[6];
 } nrf24_user_cfg_t;
 
+#define NRF24_REGFILE_SIZE (NRF24_REG_FEATURE + 1)
+
+/* Mirror of the configuration registers */
+typedef struct {
+    // single-byte registers, indexed by register address
+    uint8_t regs[NRF24_REGFILE_SIZE];
+    // multi-byte address registers (LSB first)
+    uint8_t rx_addr_p0[5];
+    uint8_t rx_addr_p1[5];
+    uint8_t tx_addr[5];
+} nrf24_regfile_t;
+
+/* Configuration transaction (staged changes, see `nrf24_cfg_begin()`) */
+typedef struct {
+    nrf24_regfile_t regs;
+    // bits staged per single-byte register; only these are committed
+    uint8_t staged[NRF24_REGFILE_SIZE];
+    // staged addresses: bit 0 RX_ADDR_P0, bit 1 RX_ADDR_P1, bit 2 TX_ADDR
+    uint8_t staged_addrs;
+} nrf24_cfg_txn_t;
+
+/* Power states (see `nrf24_pwr_request()`) */
+typedef enum {
+    NRF24_PWR_DOWN = 0,
+    NRF24_PWR_STANDBY_I,  // powered up, CE low
+    NRF24_PWR_STANDBY_II, // PTX, CE high, TX FIFO empty
+    NRF24_PWR_RX,
+    NRF24_PWR_TX,
+    NRF24_PWR_STATE_NUM,
+} nrf24_pwr_state_t;
+
+/* Settle times (us) */
+#ifndef NRF24_TPD2STBY_US
+#define NRF24_TPD2STBY_US 1500
+#endif
+#ifndef NRF24_TSTBY2A_US
+#define NRF24_TSTBY2A_US 130
+#endif
+
+typedef struct {
+    nrf24_pwr_state_t state;
+    uint8_t is_pwr_up;
+    uint32_t since_us; // entry of `state` (only for `nrf24_pwr_request()` transitions)
+    uint32_t ready_us; // earliest time `state` is usable
+    uint32_t residency_us[NRF24_PWR_STATE_NUM];
+    uint32_t transitions;
+    uint32_t skipped;  // requests that needed no I/O
+} nrf24_pwr_t;
+
 typedef struct nrf24 {
     nrf24_dep_t dep; // Note: keep as the first member
     nrf24_role_enum_t role;
@@ -104,14 +176,33 @@ typedef struct nrf24 {
     uint8_t ack_pipe; // PRX txfifo target pipe
     uint8_t is_radio_on;
 
+    uint8_t is_shadow_valid;
+    nrf24_regfile_t shadow; // cached configuration registers
+
+    nrf24_pwr_t pwr;
+
+#ifdef NRF24L01_ENABLE_TIMESTAMP
+    struct {
+        volatile uint32_t irq_us;
+        volatile uint8_t is_irq_stamped;
+        uint8_t stamped; // STATUS flags already stamped
+        uint32_t rx_us;
+        uint32_t tx_us;
+    } ts;
+#endif
+
 #ifdef NRF24L01_ENABLE_CUSTOM_STRUCT_DATA
     NRF24L01_CUSTOM_STRUCT_DATA_T custom_data;
 #endif
 
 } nrf24_t;
 
-extern nrf24_regval_t nrf24_default_regval_list[];
+/* Register image terminator (see `nrf24_write_reg_image()`) */
+#define NRF24_REGIMAGE_END ((uint8_t)0xFF)
+
+extern const nrf24_regval_t nrf24_default_regval_list[];
 extern const int nrf24_default_regval_list_num;
+extern const uint8_t nrf24_default_regimage[];
 
 /* Using C11 features to enhace checking */
 #if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
@@ -127,6 +218,8 @@ int nrf24_init(nrf24_t *nrf24, nrf24_dep_ops_t *ops, void *ops_ctx);
 int nrf24_check_device(nrf24_t *nrf24);
 int nrf24_setup(nrf24_t *nrf24, nrf24_role_enum_t role);
 int nrf24_setup_full(nrf24_t *nrf24, nrf24_role_enum_t role, const nrf24_user_cfg_t *ucfg, const nrf24_regval_t *regvals, int regvals_num);
+int nrf24_setup_image(nrf24_t *nrf24, nrf24_role_enum_t role, const nrf24_user_cfg_t *ucfg, const uint8_t *image);
+int nrf24_setup_fast(nrf24_t *nrf24, nrf24_role_enum_t role, const nrf24_user_cfg_t *ucfg, const uint8_t *image);
 void nrf24_deinit(nrf24_t *nrf24);
 
 /**********/
@@ -139,10 +232,25 @@ int nrf24_usercfg_write(nrf24_t *nrf24, const nrf24_user_cfg_t *ucfg);
 int nrf24_usercfg_write_directly(nrf24_t *nrf24, const nrf24_user_cfg_t *ucfg);
 int nrf24_usercfg_write_diff_directly(nrf24_t *nrf24, const nrf24_user_cfg_t *old, const nrf24_user_cfg_t *new);
 
+int nrf24_cfg_begin(nrf24_t *nrf24, nrf24_cfg_txn_t *txn);
+int nrf24_cfg_set_channel(nrf24_cfg_txn_t *txn, uint8_t channel);
+int nrf24_cfg_set_rf_power(nrf24_cfg_txn_t *txn, nrf24_rfpower_enum_t power);
+int nrf24_cfg_set_adr(nrf24_cfg_txn_t *txn, nrf24_adr_enum_t adr);
+int nrf24_cfg_set_tx_addr(nrf24_cfg_txn_t *txn, const uint8_t *addr);
+int nrf24_cfg_set_rx_addr(nrf24_cfg_txn_t *txn, uint8_t pipe, const uint8_t *addr);
+int nrf24_cfg_set_rxpipe(nrf24_cfg_txn_t *txn, uint8_t pipe, uint8_t enable, uint8_t enable_aa);
+int nrf24_cfg_set_retr(nrf24_cfg_txn_t *txn, uint8_t ard, uint8_t arc);
+int nrf24_cfg_set_addr_width(nrf24_cfg_txn_t *txn, nrf24_aw_enum_t aw);
+int nrf24_cfg_set_crc(nrf24_cfg_txn_t *txn, nrf24_crc_enum_t crc);
+void nrf24_cfg_apply_usercfg(nrf24_cfg_txn_t *txn, const nrf24_user_cfg_t *ucfg);
+int nrf24_cfg_commit(nrf24_t *nrf24, const nrf24_cfg_txn_t *txn);
+int nrf24_cfg_resync(nrf24_t *nrf24);
+
 int nrf24_role_switch(nrf24_t *nrf24, nrf24_role_enum_t role);
 int nrf24_role_switch_directly(nrf24_t *nrf24, nrf24_role_enum_t role);
 int nrf24_role_is_prx(nrf24_t *nrf24);
 int nrf24_role_is_ptx(nrf24_t *nrf24);
+int nrf24_turnaround(nrf24_t *nrf24, nrf24_role_enum_t role, const uint8_t *data, uint8_t len, uint32_t now_us);
 
 /**********/
 /* Switch */
@@ -179,6 +287,7 @@ void nrf24_txfifo_flush(nrf24_t *nrf24);
 int nrf24_txfifo_prx_write(nrf24_t *nrf24, const uint8_t *data, uint8_t len, uint8_t pipe);
 int nrf24_txfifo_ptx_write(nrf24_t *nrf24, const uint8_t *data, uint8_t len);
 int nrf24_txfifo_ptx_write_no_ack(nrf24_t *nrf24, const uint8_t *data, uint8_t len);
+int nrf24_txfifo_reuse(nrf24_t *nrf24);
 
 void nrf24_txfifo_set_prx_ackpipe(nrf24_t *nrf24, uint8_t pipe);
 uint8_t nrf24_txfifo_get_prx_ackpipe(nrf24_t *nrf24);
@@ -189,12 +298,51 @@ int nrf24_rxfifo_is_full(nrf24_t *nrf24);
 int nrf24_rxfifo_read(nrf24_t *nrf24, uint8_t *buf, uint8_t *data_len, uint8_t *pipe);
 void nrf24_rxfifo_flush(nrf24_t *nrf24);
 
+/*********/
+/* Power */
+/*********/
+
+int nrf24_pwr_request(nrf24_t *nrf24, nrf24_pwr_state_t target, uint32_t now_us);
+nrf24_pwr_state_t nrf24_pwr_state(nrf24_t *nrf24);
+uint32_t nrf24_pwr_ready_at(nrf24_t *nrf24);
+int nrf24_pwr_is_ready(nrf24_t *nrf24, uint32_t now_us);
+uint32_t nrf24_pwr_residency(nrf24_t *nrf24, nrf24_pwr_state_t state, uint32_t now_us);
+
+/***************/
+/* Destination */
+/***************/
+
+int nrf24_dest_set(nrf24_t *nrf24, const uint8_t *addr);
+int nrf24_dest_get(nrf24_t *nrf24, uint8_t *addr);
+int nrf24_dest_is_current(nrf24_t *nrf24, const uint8_t *addr);
+uint8_t nrf24_addr_width(nrf24_t *nrf24);
+
 /***********/
 /* Running */
 /***********/
 
 nrf24_status_enum_t nrf24_status_routine(nrf24_t *nrf24, uint8_t sta);
 
+/***********/
+/* Trace */
+/***********/
+
+#ifdef NRF24L01_ENABLE_TRACE
+int nrf24_trace_attach(nrf24_t *nrf24, nrf24_trace_t *trace, nrf24_trace_rec_t *recs, uint32_t num);
+void nrf24_trace_detach(nrf24_t *nrf24);
+int nrf24_trace_snapshot(const nrf24_trace_t *trace, nrf24_trace_hdr_t *hdr, nrf24_trace_rec_t *out, int max);
+#endif
+
+/*************/
+/* Timestamp */
+/*************/
+
+#ifdef NRF24L01_ENABLE_TIMESTAMP
+void nrf24_irq_stamp(nrf24_t *nrf24);
+uint32_t nrf24_rx_timestamp(nrf24_t *nrf24);
+uint32_t nrf24_tx_timestamp(nrf24_t *nrf24);
+#endif
+
 /***********/
 /* Utils */
 /***********/
@@ -204,6 +352,8 @@ int nrf24_read_regs(nrf24_t *nrf24, uint8_t reg, uint8_t *vals, uint8_t len);
 int nrf24_write_reg(nrf24_t *nrf24, uint8_t reg, uint8_t val);
 int nrf24_write_regs(nrf24_t *nrf24, uint8_t reg, uint8_t *vals, uint8_t len);
 int nrf24_write_reg_list(nrf24_t *nrf24, const nrf24_regval_t *regvals, int num);
+int nrf24_write_reg_image(nrf24_t *nrf24, const uint8_t *image);
+int nrf24_reg_image_lookup(const uint8_t *image, uint8_t reg, uint8_t *val);
 
 
 #endif // NRF24L01_H
\ No newline at end of file
@@ -0,0 +1,176 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_backoff.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+/**
+ * @brief Derive a per-node seed from an address (e.g. the node's own RX address).
+ *
+ * Mix in something noisy (ADC LSBs, a unique id) where available.
+ */
+uint32_t nrf24_backoff_seed(const uint8_t *addr, uint8_t len)
+{
+    uint32_t h = 2166136261u; // FNV-1a
+
+    for (int i = 0; i < len; i++) {
+        h ^= addr[i];
+        h *= 16777619u;
+    }
+
+    return h;
+}
+
+/**
+ * @brief Initialize a backoff policy (no I/O).
+ *
+ * @param seed  Per-node seed, nodes with the same seed back off in lockstep.
+ * @return 0 on success.
+ */
+int nrf24_backoff_init(nrf24_backoff_t *bo, uint32_t seed)
+{
+    CHECK(bo != 0);
+
+    bo->slot_us = 250;
+    bo->max_exp = 8;
+    bo->arc_hi = 2;
+
+    bo->rng = seed != 0 ? seed : 0x6D2B79F5u;
+    bo->exp = 0;
+    bo->is_fail_pending = 0;
+    bo->until_us = 0;
+
+    bo->stats.sent = 0;
+    bo->stats.fails = 0;
+    bo->stats.backoffs_us = 0;
+    bo->stats.contended = 0;
+    bo->stats.retries = 0;
+    bo->stats.max_exp_seen = 0;
+
+    return 0;
+}
+
+static uint32_t rand32(nrf24_backoff_t *bo)
+{
+    uint32_t x = bo->rng; // xorshift32
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    bo->rng = x;
+
+    return x;
+}
+
+/**
+ * @brief Record a failed transmission (MAX_RT) and start a backoff.
+ *
+ * @return The backoff time in us.
+ */
+uint32_t nrf24_backoff_on_fail(nrf24_backoff_t *bo, uint32_t now_us)
+{
+    uint32_t window;
+    uint32_t wait;
+
+    if (bo->exp < bo->max_exp) {
+        bo->exp++;
+    }
+    if (bo->exp > bo->stats.max_exp_seen) {
+        bo->stats.max_exp_seen = bo->exp;
+    }
+
+    /* [slot, slot << exp) */
+    window = (bo->slot_us << bo->exp) - bo->slot_us;
+    wait = bo->slot_us + (window ? rand32(bo) % window : 0);
+
+    bo->until_us = now_us + wait;
+    bo->is_fail_pending = 1;
+    bo->stats.fails++;
+    bo->stats.backoffs_us += wait;
+
+    return wait;
+}
+
+/**
+ * @brief Record a successful transmission.
+ *
+ * @param arc  Retransmissions it took (`nrf24_read_observe().arc_cnt`).
+ */
+void nrf24_backoff_on_success(nrf24_backoff_t *bo, uint8_t arc)
+{
+    bo->stats.sent++;
+    bo->stats.retries += arc;
+
+    if (arc >= bo->arc_hi) {
+        bo->stats.contended++; // channel busy, keep the pressure off
+    } else if (bo->exp > 0) {
+        bo->exp--;
+    }
+}
+
+/**
+ * @brief Feed a `nrf24_status_routine()` result; reads OBSERVE_TX on TX events.
+ *
+ * MAX_RT stays set until `nrf24_backoff_resume()`, so TX_FAIL is reported on
+ * every poll meanwhile; only the first one starts a backoff.
+ *
+ * @return Time in us until the next transmission is allowed (0: now).
+ */
+uint32_t nrf24_backoff_event(nrf24_backoff_t *bo, nrf24_t *nrf24, int result, uint32_t now_us)
+{
+    if (result & NRF24_STA_TX_FAIL) {
+        if (!bo->is_fail_pending) {
+            nrf24_backoff_on_fail(bo, now_us);
+        }
+    } else if (result & NRF24_STA_TX_SENT) {
+        nrf24_backoff_on_success(bo, nrf24_read_observe(nrf24).arc_cnt);
+    }
+
+    return nrf24_backoff_wait_us(bo, now_us);
+}
+
+/// 1 if transmitting is allowed at `now_us`.
+int nrf24_backoff_may_tx(const nrf24_backoff_t *bo, uint32_t now_us)
+{
+    return (int32_t)(now_us - bo->until_us) >= 0;
+}
+
+/// Time in us until transmitting is allowed (0: now).
+uint32_t nrf24_backoff_wait_us(const nrf24_backoff_t *bo, uint32_t now_us)
+{
+    int32_t left = (int32_t)(bo->until_us - now_us);
+
+    return left > 0 ? (uint32_t)left : 0;
+}
+
+/**
+ * @brief Let the chip retry the packet that failed (clears MAX_RT).
+ *
+ * Call once `nrf24_backoff_may_tx()` is true; does nothing if no failure is pending.
+ *
+ * @return 1 if a retry was released, 0 otherwise.
+ */
+int nrf24_backoff_resume(nrf24_backoff_t *bo, nrf24_t *nrf24)
+{
+    if (!bo->is_fail_pending) {
+        return 0;
+    }
+
+    bo->is_fail_pending = 0;
+    nrf24_clear_txfail_flag(nrf24);
+
+    return 1;
+}
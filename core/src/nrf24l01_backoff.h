@@ -0,0 +1,69 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_BACKOFF_H
+#define NRF24L01_BACKOFF_H
+
+#include "nrf24l01.h"
+
+/* Randomized exponential backoff for contending PTX nodes
+ *
+ * The chip retransmits after a fixed ARD, so nodes that collided once
+ * tend to collide again; a fixed pause after MAX_RT keeps them in lockstep.
+ * Instead, after every MAX_RT the node waits a random time in
+ * `[slot_us, slot_us << exp)` (exp grows by one per failure up to
+ * `max_exp`), from a per-node seeded generator.
+ *
+ * ARC (retransmissions of the last packet, from OBSERVE_TX) is the
+ * contention signal on success: a packet that needed `arc_hi` or more
+ * retries keeps the current exponent, a clean one lowers it by one.
+ *
+ *   result = nrf24_status_routine(nrf24, nrf24_read_and_clear_status(nrf24));
+ *   nrf24_backoff_event(&bo, nrf24, result, now_us);
+ *   if (nrf24_backoff_may_tx(&bo, now_us)) {
+ *       nrf24_backoff_resume(&bo, nrf24);   // retry a failed packet, if any
+ *       ... write more packets ...
+ *   }
+ */
+
+typedef struct {
+    uint32_t sent;
+    uint32_t fails;             // MAX_RT events
+    uint32_t backoffs_us;       // total time backed off
+    uint32_t contended;         // successes with ARC >= arc_hi
+    uint32_t retries;           // sum of ARC over successes
+    uint8_t max_exp_seen;
+} nrf24_backoff_stats_t;
+
+typedef struct {
+    // parameters (defaults set by `nrf24_backoff_init()`)
+    uint32_t slot_us;           // default 250
+    uint8_t max_exp;            // default 8 (max wait: slot_us << 8 = 64 ms)
+    uint8_t arc_hi;             // default 2
+
+    // state
+    uint32_t rng;
+    uint8_t exp;
+    uint8_t is_fail_pending;    // MAX_RT seen, packet still at the TX FIFO head
+    uint32_t until_us;          // no transmission before this time
+
+    nrf24_backoff_stats_t stats;
+} nrf24_backoff_t;
+
+uint32_t nrf24_backoff_seed(const uint8_t *addr, uint8_t len);
+int nrf24_backoff_init(nrf24_backoff_t *bo, uint32_t seed);
+uint32_t nrf24_backoff_on_fail(nrf24_backoff_t *bo, uint32_t now_us);
+void nrf24_backoff_on_success(nrf24_backoff_t *bo, uint8_t arc);
+uint32_t nrf24_backoff_event(nrf24_backoff_t *bo, nrf24_t *nrf24, int result, uint32_t now_us);
+int nrf24_backoff_may_tx(const nrf24_backoff_t *bo, uint32_t now_us);
+uint32_t nrf24_backoff_wait_us(const nrf24_backoff_t *bo, uint32_t now_us);
+int nrf24_backoff_resume(nrf24_backoff_t *bo, nrf24_t *nrf24);
+
+#endif // NRF24L01_BACKOFF_H
@@ -0,0 +1,198 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_beacon.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+/**
+ * @brief Initialize a beacon (no I/O); the radio must be set up as PTX.
+ *
+ * @param interval_ms  PERIODIC: time between repetitions.
+ * @return 0 on success.
+ */
+int nrf24_beacon_init(nrf24_beacon_t *b, nrf24_t *nrf24, nrf24_beacon_mode_t mode, uint32_t interval_ms)
+{
+    CHECK(b != 0 && nrf24 != 0);
+    CHECK(mode == NRF24_BEACON_CONTINUOUS || interval_ms > 0);
+
+    b->nrf24 = nrf24;
+    b->mode = mode;
+    b->interval_ms = interval_ms;
+    b->settle_ms = 2;
+    b->no_ack = 1;
+    b->delay_us = 0;
+
+    b->is_running = 0;
+    b->is_in_flight = 0;
+    b->is_swap_pending = 0;
+    b->swap_len = 0;
+    b->next_ms = 0;
+    b->last_ms = 0;
+
+    b->stats.repeats = 0;
+    b->stats.swaps = 0;
+    b->stats.max_rt = 0;
+
+    return 0;
+}
+
+/// Replace the payload in the TX FIFO and mark it for reuse (CE must be low, nothing in flight)
+static int load(nrf24_beacon_t *b, const uint8_t *data, uint8_t len)
+{
+    nrf24_t *nrf24 = b->nrf24;
+    int ret = 0;
+
+    nrf24_txfifo_flush(nrf24);
+    if (b->no_ack) {
+        ret += nrf24_txfifo_ptx_write_no_ack(nrf24, data, len);
+    } else {
+        ret += nrf24_txfifo_ptx_write(nrf24, data, len);
+    }
+    ret += nrf24_txfifo_reuse(nrf24);
+    b->stats.swaps++;
+
+    return ret;
+}
+
+/**
+ * @brief Load the beacon and start repeating it.
+ *
+ * PERIODIC sends the first repetition on the first poll at or after `now_ms`.
+ *
+ * @return 0 on success.
+ */
+int nrf24_beacon_start(nrf24_beacon_t *b, const uint8_t *data, uint8_t len, uint32_t now_ms)
+{
+    int ret;
+
+    CHECK(data != 0 && len > 0 && len <= 32);
+    CHECK(b->mode == NRF24_BEACON_CONTINUOUS || b->delay_us != 0);
+
+    nrf24_radio_off(b->nrf24);
+    ret = load(b, data, len);
+
+    b->is_running = 1;
+    b->is_in_flight = 0;
+    b->is_swap_pending = 0;
+    b->next_ms = now_ms;
+
+    if (b->mode == NRF24_BEACON_CONTINUOUS) {
+        nrf24_radio_on(b->nrf24);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Stage a new beacon; it replaces the current one in `nrf24_beacon_poll()`
+ * as soon as no repetition is in the air.
+ *
+ * @return 0 on success.
+ */
+int nrf24_beacon_set(nrf24_beacon_t *b, const uint8_t *data, uint8_t len)
+{
+    CHECK(data != 0 && len > 0 && len <= 32);
+
+    for (int i = 0; i < len; i++) {
+        b->swap_buf[i] = data[i];
+    }
+    b->swap_len = len;
+    b->is_swap_pending = 1;
+
+    return 0;
+}
+
+static void pulse(nrf24_beacon_t *b)
+{
+    nrf24_radio_on(b->nrf24);
+    b->delay_us(10);
+    nrf24_radio_off(b->nrf24);
+}
+
+/**
+ * @brief Send due repetitions and swap in a staged beacon; call often.
+ *
+ * @param now_ms  Current time.
+ * @return Number of repetitions started (PERIODIC), 0 otherwise.
+ */
+int nrf24_beacon_poll(nrf24_beacon_t *b, uint32_t now_ms)
+{
+    nrf24_t *nrf24 = b->nrf24;
+    int n = 0;
+
+    if (!b->is_running) {
+        return 0;
+    }
+
+    if (b->is_in_flight && now_ms - b->last_ms >= b->settle_ms) {
+        b->is_in_flight = 0;
+    }
+
+    if (!b->no_ack) {
+        int result = nrf24_status_routine(nrf24, nrf24_read_and_clear_status(nrf24));
+        if (result & NRF24_STA_TX_FAIL) {
+            b->stats.max_rt++;
+            nrf24_clear_txfail_flag(nrf24);
+        }
+        if (result & (NRF24_STA_TX_SENT | NRF24_STA_TX_FAIL)) {
+            b->is_in_flight = 0;
+        }
+    }
+
+    if (b->is_swap_pending) {
+        if (b->mode == NRF24_BEACON_CONTINUOUS && nrf24->is_radio_on) {
+            /* stop repeating, swap once the last one is done */
+            nrf24_radio_off(nrf24);
+            if (!b->no_ack) {
+                nrf24_read_and_clear_status(nrf24);
+            }
+            b->is_in_flight = 1;
+            b->last_ms = now_ms;
+            return 0;
+        }
+        if (b->is_in_flight) {
+            return 0;
+        }
+
+        load(b, b->swap_buf, b->swap_len);
+        b->is_swap_pending = 0;
+        if (b->mode == NRF24_BEACON_CONTINUOUS) {
+            nrf24_radio_on(nrf24);
+        }
+    }
+
+    if (b->mode == NRF24_BEACON_PERIODIC && (int32_t)(now_ms - b->next_ms) >= 0) {
+        pulse(b);
+        b->is_in_flight = 1;
+        b->last_ms = now_ms;
+        b->stats.repeats++;
+        n++;
+
+        b->next_ms += b->interval_ms;
+        if ((int32_t)(now_ms - b->next_ms) >= 0) {
+            b->next_ms = now_ms + b->interval_ms; // fell behind, do not burst
+        }
+    }
+
+    return n;
+}
+
+/// Stop repeating; the beacon stays loaded in the TX FIFO.
+void nrf24_beacon_stop(nrf24_beacon_t *b)
+{
+    b->is_running = 0;
+    nrf24_radio_off(b->nrf24);
+}
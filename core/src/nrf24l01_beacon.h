@@ -0,0 +1,66 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_BEACON_H
+#define NRF24L01_BEACON_H
+
+#include "nrf24l01.h"
+
+/* Beacon mode (PTX)
+ *
+ * The beacon payload is written once and marked for reuse (REUSE_TX_PL);
+ * every repetition is then only a CE pulse (PERIODIC) or happens back to
+ * back while CE stays high (CONTINUOUS), with no payload traffic on SPI.
+ *
+ * `nrf24_beacon_set()` stages a new payload; `nrf24_beacon_poll()` swaps it
+ * in once the beacon in the air has finished, so receivers never see a
+ * mixed or missing beacon.
+ */
+
+typedef enum {
+    NRF24_BEACON_PERIODIC = 0,
+    NRF24_BEACON_CONTINUOUS = 1,
+} nrf24_beacon_mode_t;
+
+typedef struct {
+    uint32_t repeats;        // CE pulses (PERIODIC)
+    uint32_t swaps;          // payload loads (start + swaps)
+    uint32_t max_rt;         // ACK mode only
+} nrf24_beacon_stats_t;
+
+typedef struct {
+    nrf24_t *nrf24;
+    nrf24_beacon_mode_t mode;
+
+    // parameters (defaults set by `nrf24_beacon_init()`)
+    uint32_t interval_ms;         // PERIODIC
+    uint32_t settle_ms;           // max air time of one beacon (incl. retries), default 2
+    uint8_t no_ack;               // default 1, ACK mode reads STATUS on every poll
+    void (*delay_us)(uint32_t us); // CE pulse width (>= 10 us), required for PERIODIC
+
+    // state
+    uint8_t is_running;
+    uint8_t is_in_flight;
+    uint8_t is_swap_pending;
+    uint8_t swap_len;
+    uint8_t swap_buf[32];
+    uint32_t next_ms;
+    uint32_t last_ms;
+
+    nrf24_beacon_stats_t stats;
+} nrf24_beacon_t;
+
+int nrf24_beacon_init(nrf24_beacon_t *b, nrf24_t *nrf24, nrf24_beacon_mode_t mode, uint32_t interval_ms);
+int nrf24_beacon_start(nrf24_beacon_t *b, const uint8_t *data, uint8_t len, uint32_t now_ms);
+int nrf24_beacon_set(nrf24_beacon_t *b, const uint8_t *data, uint8_t len);
+int nrf24_beacon_poll(nrf24_beacon_t *b, uint32_t now_ms);
+void nrf24_beacon_stop(nrf24_beacon_t *b);
+
+#endif // NRF24L01_BEACON_H
@@ -0,0 +1,312 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_bond.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+/**
+ * @brief Initialize a bonded link (no I/O).
+ *
+ * @param tx_radio  Initialized instance used as PTX.
+ * @param rx_radio  Initialized instance used as PRX.
+ * @param txq       Send queue storage.
+ * @param rxq       Receive queue storage, its size is the flow control window.
+ * @return 0 on success.
+ *
+ * @attention Both ends must use the same receive queue size.
+ */
+int nrf24_bond_init(nrf24_bond_t *bond, nrf24_t *tx_radio, nrf24_t *rx_radio,
+                    nrf24_bond_slot_t *txq, uint8_t txq_num, nrf24_bond_slot_t *rxq, uint8_t rxq_num)
+{
+    CHECK(bond != 0 && tx_radio != 0 && rx_radio != 0 && tx_radio != rx_radio);
+    CHECK(txq != 0 && txq_num > 0 && rxq != 0 && rxq_num > 0 && rxq_num < 128);
+
+    bond->tx_radio = tx_radio;
+    bond->rx_radio = rx_radio;
+    bond->txq = txq;
+    bond->txq_num = txq_num;
+    bond->txq_head = 0;
+    bond->txq_count = 0;
+    bond->rxq = rxq;
+    bond->rxq_num = rxq_num;
+    bond->rxq_head = 0;
+    bond->rxq_count = 0;
+
+    bond->window = rxq_num;
+    bond->tx_seq = 0;
+    bond->peer_consumed = 0;
+    bond->rx_expect = 0;
+    bond->rx_synced = 0;
+    bond->consumed = 0;
+    bond->advertised = 0;
+    bond->need_sync = 0;
+
+    bond->max_rt_limit = 8;
+    bond->max_rt_run = 0;
+
+    bond->stats = (nrf24_bond_stats_t){0};
+
+    return 0;
+}
+
+/**
+ * @brief Bring up both radios.
+ *
+ * @param ucfg        Base user config (addresses, rate, power), channel is overridden.
+ * @param tx_channel  Channel of the local PTX (= peer's `rx_channel`).
+ * @param rx_channel  Channel of the local PRX (= peer's `tx_channel`).
+ * @return 0 on success.
+ */
+int nrf24_bond_setup(nrf24_bond_t *bond, const nrf24_user_cfg_t *ucfg, uint8_t tx_channel, uint8_t rx_channel)
+{
+    int ret = 0;
+    nrf24_user_cfg_t cfg = *ucfg;
+
+    CHECK(tx_channel <= 125 && rx_channel <= 125 && tx_channel != rx_channel);
+
+    cfg.rf_channel = tx_channel;
+    ret += nrf24_setup_image(bond->tx_radio, NRF24_ROLE_PTX, &cfg, nrf24_default_regimage);
+
+    cfg.rf_channel = rx_channel;
+    ret += nrf24_setup_image(bond->rx_radio, NRF24_ROLE_PRX, &cfg, nrf24_default_regimage);
+
+    return ret;
+}
+
+/**
+ * @brief Queue data for sending.
+ *
+ * @param len  1 ~ NRF24_BOND_MTU
+ * @return 0 on success, `NRF24_ERR_BUSY` if the send queue is full.
+ */
+int nrf24_bond_send(nrf24_bond_t *bond, const uint8_t *data, uint8_t len)
+{
+    nrf24_bond_slot_t *s;
+
+    CHECK(len > 0 && len <= NRF24_BOND_MTU);
+
+    if (bond->txq_count >= bond->txq_num) {
+        return NRF24_ERR_BUSY;
+    }
+
+    s = &bond->txq[(bond->txq_head + bond->txq_count) % bond->txq_num];
+    s->len = len;
+    for (int i = 0; i < len; i++) {
+        s->data[i] = data[i];
+    }
+    bond->txq_count++;
+
+    return 0;
+}
+
+/**
+ * @brief Take received data (in order).
+ *
+ * @param[out] buf  At least NRF24_BOND_MTU bytes.
+ * @return 0 on success, -1 if nothing received.
+ */
+int nrf24_bond_recv(nrf24_bond_t *bond, uint8_t *buf, uint8_t *len)
+{
+    nrf24_bond_slot_t *s;
+
+    if (bond->rxq_count == 0) {
+        return -1;
+    }
+
+    s = &bond->rxq[bond->rxq_head];
+    *len = s->len;
+    for (int i = 0; i < s->len; i++) {
+        buf[i] = s->data[i];
+    }
+    bond->rxq_head = (bond->rxq_head + 1) % bond->rxq_num;
+    bond->rxq_count--;
+    bond->consumed++;
+
+    return 0;
+}
+
+/**
+ * @brief Move the receive sequence to `seq`, releasing the credit of skipped frames.
+ *
+ * @return 0 on success, -1 if `seq` is behind (duplicate).
+ */
+static int rx_advance(nrf24_bond_t *bond, uint8_t seq)
+{
+    int8_t d = (int8_t)(seq - bond->rx_expect);
+
+    if (bond->rx_synced) {
+        if (d < 0) {
+            return -1;
+        }
+        bond->stats.gaps += d;
+    }
+
+    // keeps `rx_expect - consumed == rxq_count`
+    bond->consumed += (uint8_t)(seq - bond->rx_expect);
+    bond->rx_expect = seq;
+    bond->rx_synced = 1;
+
+    return 0;
+}
+
+static void on_frame(nrf24_bond_t *bond, const uint8_t *buf, uint8_t len)
+{
+    uint8_t seq;
+    nrf24_bond_slot_t *s;
+
+    if (len < NRF24_BOND_HDR_SIZE) {
+        return;
+    }
+
+    bond->peer_consumed = buf[1];
+    seq = buf[0];
+
+    if (len == NRF24_BOND_HDR_SIZE) {
+        rx_advance(bond, seq); // credit update, skips frames the peer flushed
+        return;
+    }
+
+    if (rx_advance(bond, seq) != 0) {
+        bond->stats.dups++;
+        return;
+    }
+    bond->rx_expect++;
+
+    if (bond->rxq_count >= bond->rxq_num) {
+        bond->stats.rx_overflow++;
+        bond->consumed++; // dropped, release its credit
+        return;
+    }
+
+    s = &bond->rxq[(bond->rxq_head + bond->rxq_count) % bond->rxq_num];
+    s->len = len - NRF24_BOND_HDR_SIZE;
+    for (int i = 0; i < s->len; i++) {
+        s->data[i] = buf[NRF24_BOND_HDR_SIZE + i];
+    }
+    bond->rxq_count++;
+    bond->stats.rx_frames++;
+}
+
+/// @return number of received frames
+static int service_rx(nrf24_bond_t *bond)
+{
+    nrf24_t *rx = bond->rx_radio;
+    uint8_t buf[32];
+    uint8_t len;
+    int n = 0;
+
+    if (!(nrf24_status_routine(rx, nrf24_read_and_clear_status(rx)) & NRF24_STA_HAS_RXDATA)) {
+        return 0;
+    }
+
+    while (nrf24_rxfifo_has_data(rx)) {
+        if (nrf24_rxfifo_read(rx, buf, &len, 0) != 0) {
+            break;
+        }
+        on_frame(bond, buf, len);
+        n++;
+    }
+
+    return n;
+}
+
+/// @return number of frames written to the TX FIFO
+static int service_tx(nrf24_bond_t *bond)
+{
+    nrf24_t *tx = bond->tx_radio;
+    uint8_t buf[32];
+    int result;
+    int n = 0;
+
+    result = nrf24_status_routine(tx, nrf24_read_and_clear_status(tx));
+    if (result & NRF24_STA_TX_FAIL) {
+        bond->stats.max_rt++;
+        if (++bond->max_rt_run >= bond->max_rt_limit) {
+            // peer unreachable, drop what is in flight (seen as a gap by the peer)
+            nrf24_txfifo_flush(tx);
+            bond->stats.tx_resets++;
+            bond->max_rt_run = 0;
+            bond->need_sync = 1;
+        }
+        nrf24_clear_txfail_flag(tx); // retransmit (or resume after flush)
+        return 0;
+    }
+    if (result & NRF24_STA_TX_SENT) {
+        bond->max_rt_run = 0;
+    }
+
+    while (bond->txq_count > 0) {
+        nrf24_bond_slot_t *s = &bond->txq[bond->txq_head];
+
+        if ((uint8_t)(bond->tx_seq - bond->peer_consumed) >= bond->window) {
+            bond->stats.credit_stalls++;
+            break;
+        }
+        if (!nrf24_txfifo_has_space(tx)) {
+            break;
+        }
+
+        buf[0] = bond->tx_seq;
+        buf[1] = bond->consumed;
+        for (int i = 0; i < s->len; i++) {
+            buf[NRF24_BOND_HDR_SIZE + i] = s->data[i];
+        }
+        if (nrf24_txfifo_ptx_write(tx, buf, NRF24_BOND_HDR_SIZE + s->len) != 0) {
+            break;
+        }
+
+        bond->advertised = bond->consumed;
+        bond->tx_seq++;
+        bond->txq_head = (bond->txq_head + 1) % bond->txq_num;
+        bond->txq_count--;
+        bond->stats.tx_frames++;
+        n++;
+    }
+
+    /* Header-only frame: after a flush (no data followed to reveal the gap), when the peer
+       may be blocked on us, or when half a window was freed */
+    if ((bond->need_sync
+         || (bond->consumed != bond->advertised
+             && ((uint8_t)(bond->rx_expect - bond->advertised) >= bond->window
+                 || (uint8_t)(bond->consumed - bond->advertised) >= (bond->window + 1) / 2)))
+        && nrf24_txfifo_has_space(tx)) {
+        buf[0] = bond->tx_seq;
+        buf[1] = bond->consumed;
+        if (nrf24_txfifo_ptx_write(tx, buf, NRF24_BOND_HDR_SIZE) == 0) {
+            bond->advertised = bond->consumed;
+            bond->need_sync = 0;
+            bond->stats.ctrl_frames++;
+            n++;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * @brief Service both radios once (receive, then send).
+ *
+ * @return Amount of work done (0: idle).
+ */
+int nrf24_bond_poll(nrf24_bond_t *bond)
+{
+    int n = 0;
+
+    n += service_rx(bond);
+    n += service_tx(bond);
+
+    return n;
+}
@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_BOND_H
+#define NRF24L01_BOND_H
+
+#include "nrf24l01.h"
+
+/* Bonded dual-radio full-duplex link
+ *
+ * Radio A stays PTX on channel X, radio B stays PRX on channel Y; the peer
+ * uses the mirrored arrangement (PTX on Y, PRX on X), so both directions
+ * stream at the same time and no radio ever switches role.
+ *
+ * Every frame carries a 2-byte header:
+ *   [0] sequence number of this frame (header-only frames: next sequence number)
+ *   [1] number of sequence numbers released by the receiver (credit): frames
+ *       consumed by the application plus frames skipped as lost or dropped
+ * The sender keeps at most `window` frames outstanding beyond the peer's
+ * released count, `window` being the receive queue size (same on both ends).
+ * A header-only frame carries a credit update when there is no data to send;
+ * one is also sent after the TX FIFO was flushed so the peer skips the lost
+ * frames and releases their credit even if no more data follows.
+ */
+
+#define NRF24_BOND_HDR_SIZE 2
+#define NRF24_BOND_MTU      (32 - NRF24_BOND_HDR_SIZE)
+
+typedef struct {
+    uint8_t len;
+    uint8_t data[NRF24_BOND_MTU];
+} nrf24_bond_slot_t;
+
+typedef struct {
+    uint32_t tx_frames;
+    uint32_t rx_frames;
+    uint32_t ctrl_frames;  // credit-only frames sent
+    uint32_t dups;         // duplicate frames dropped
+    uint32_t gaps;         // missing frames (peer gave up on them)
+    uint32_t rx_overflow;  // frames dropped, receive queue full (window mismatch)
+    uint32_t max_rt;       // retransmit limit hits
+    uint32_t tx_resets;    // TX FIFO flushed after `max_rt_limit` consecutive failures
+    uint32_t credit_stalls; // polls with data pending but no credit
+} nrf24_bond_stats_t;
+
+typedef struct {
+    nrf24_t *tx_radio;
+    nrf24_t *rx_radio;
+
+    // queues (caller storage, rings)
+    nrf24_bond_slot_t *txq;
+    uint8_t txq_num;
+    uint8_t txq_head;
+    uint8_t txq_count;
+    nrf24_bond_slot_t *rxq;
+    uint8_t rxq_num;
+    uint8_t rxq_head;
+    uint8_t rxq_count;
+
+    // sequencing / flow control
+    uint8_t window;
+    uint8_t tx_seq;        // next sequence number to send
+    uint8_t peer_consumed; // peer's released count (from its frames)
+    uint8_t rx_expect;     // next expected sequence number
+    uint8_t rx_synced;
+    uint8_t consumed;      // sequence numbers released (consumed, skipped or dropped)
+    uint8_t advertised;    // consumed count last sent to the peer
+    uint8_t need_sync;     // send the next sequence number after a TX FIFO flush
+
+    uint8_t max_rt_limit;  // consecutive MAX_RT before flushing (default 8)
+    uint8_t max_rt_run;
+
+    nrf24_bond_stats_t stats;
+} nrf24_bond_t;
+
+int nrf24_bond_init(nrf24_bond_t *bond, nrf24_t *tx_radio, nrf24_t *rx_radio,
+                    nrf24_bond_slot_t *txq, uint8_t txq_num, nrf24_bond_slot_t *rxq, uint8_t rxq_num);
+int nrf24_bond_setup(nrf24_bond_t *bond, const nrf24_user_cfg_t *ucfg, uint8_t tx_channel, uint8_t rx_channel);
+int nrf24_bond_send(nrf24_bond_t *bond, const uint8_t *data, uint8_t len);
+int nrf24_bond_recv(nrf24_bond_t *bond, uint8_t *buf, uint8_t *len);
+int nrf24_bond_poll(nrf24_bond_t *bond);
+
+#endif // NRF24L01_BOND_H
@@ -0,0 +1,478 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_bulk.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+#define FRAME_START   0x01
+#define FRAME_DATA    0x02
+#define FRAME_POLL    0x03
+#define FRAME_STATUS  0x81
+
+static void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    put16(p, (uint16_t)v);
+    put16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return get16(p) | ((uint32_t)get16(p + 2) << 16);
+}
+
+static uint8_t block_len(uint32_t size, uint32_t block)
+{
+    uint32_t left = size - block * NRF24_BULK_BLOCK;
+    return left < NRF24_BULK_BLOCK ? (uint8_t)left : NRF24_BULK_BLOCK;
+}
+
+/**************/
+/*   Sender   */
+/**************/
+
+/**
+ * @brief Initialize a transfer (no I/O); the radio must be set up as PTX
+ * with ACK payloads enabled and be on (CE high).
+ *
+ * @param id    Transfer id; the receiver keeps its bitmap for a START with the id it saved.
+ * @param size  Bytes to send (1..NRF24_BULK_MAX_BLOCKS blocks).
+ * @param read  Data source.
+ * @return 0 on success.
+ */
+int nrf24_bulk_tx_init(nrf24_bulk_tx_t *tx, nrf24_t *nrf24, uint16_t id, uint32_t size, nrf24_bulk_read_t read, void *ctx)
+{
+    uint32_t blocks = (size + NRF24_BULK_BLOCK - 1) / NRF24_BULK_BLOCK;
+
+    CHECK(tx != 0 && nrf24 != 0 && read != 0);
+    CHECK(blocks > 0 && blocks <= NRF24_BULK_MAX_BLOCKS);
+
+    tx->nrf24 = nrf24;
+    tx->read = read;
+    tx->ctx = ctx;
+    tx->id = id;
+    tx->blocks = (uint16_t)blocks;
+    tx->size = size;
+    tx->poll_interval_ms = 1;
+
+    tx->state = NRF24_BULK_RUNNING;
+    tx->need_start = 1;
+    tx->seq = 0;
+    tx->num_ranges = 0;
+    tx->range_idx = 0;
+    tx->cursor = 0;
+    tx->last_poll_ms = 0;
+
+    tx->stats.blocks = 0;
+    tx->stats.polls = 0;
+    tx->stats.statuses = 0;
+    tx->stats.max_rt = 0;
+
+    return 0;
+}
+
+static void tx_status(nrf24_bulk_tx_t *tx, const uint8_t *buf, uint8_t len)
+{
+    uint8_t n;
+
+    if (len < 3 || buf[0] != FRAME_STATUS || buf[1] != tx->seq) {
+        return; // stale or foreign
+    }
+    n = buf[2];
+    tx->seq++;
+    tx->stats.statuses++;
+
+    if (n == 0) {
+        tx->state = NRF24_BULK_DONE;
+        return;
+    }
+    if (n == NRF24_BULK_NEED_START) {
+        tx->need_start = 1;
+        return;
+    }
+    if (n == NRF24_BULK_REJECTED || n > NRF24_BULK_RANGES || len < 3 + 4 * n) {
+        tx->state = NRF24_BULK_FAILED;
+        return;
+    }
+
+    for (int i = 0; i < n; i++) {
+        tx->ranges[i].first = get16(buf + 3 + 4 * i);
+        tx->ranges[i].count = get16(buf + 5 + 4 * i);
+    }
+    tx->num_ranges = n;
+    tx->range_idx = 0;
+    tx->cursor = tx->ranges[0].first;
+}
+
+/// Write the next frame; 1 if one was written, 0 if there is nothing to send now
+static int tx_next(nrf24_bulk_tx_t *tx, nrf24_fifosta_t fifosta, uint32_t now_ms)
+{
+    nrf24_t *nrf24 = tx->nrf24;
+    uint8_t frame[32];
+
+    if (tx->need_start) {
+        frame[0] = FRAME_START;
+        put16(frame + 1, tx->id);
+        put16(frame + 3, tx->blocks);
+        put32(frame + 5, tx->size);
+        if (nrf24_txfifo_ptx_write(nrf24, frame, 9) != 0) {
+            return 0;
+        }
+        tx->need_start = 0;
+        return 1;
+    }
+
+    while (tx->range_idx < tx->num_ranges) {
+        nrf24_bulk_range_t *r = &tx->ranges[tx->range_idx];
+        uint8_t len;
+
+        if (tx->cursor >= (uint32_t)r->first + r->count || tx->cursor >= tx->blocks) {
+            if (++tx->range_idx < tx->num_ranges) {
+                tx->cursor = tx->ranges[tx->range_idx].first;
+            }
+            continue;
+        }
+
+        len = block_len(tx->size, tx->cursor);
+        frame[0] = FRAME_DATA;
+        put16(frame + 1, (uint16_t)tx->cursor);
+        if (tx->read(tx->ctx, tx->cursor * NRF24_BULK_BLOCK, frame + 3, len) != 0) {
+            tx->state = NRF24_BULK_FAILED;
+            return 0;
+        }
+        if (nrf24_txfifo_ptx_write(nrf24, frame, len + 3) != 0) {
+            return 0;
+        }
+        tx->cursor++;
+        tx->stats.blocks++;
+        return 1;
+    }
+
+    /* all asked-for blocks are out: ask (again) what is missing */
+    if (fifosta.tx_empty && now_ms - tx->last_poll_ms >= tx->poll_interval_ms) {
+        frame[0] = FRAME_POLL;
+        frame[1] = tx->seq;
+        put16(frame + 2, tx->id);
+        if (nrf24_txfifo_ptx_write(nrf24, frame, 4) == 0) {
+            tx->last_poll_ms = now_ms;
+            tx->stats.polls++;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Keep the TX FIFO full and process status answers; call often.
+ *
+ * @param now_ms  Current time.
+ * @return Number of frames written, the transfer state is in `tx->state`.
+ */
+int nrf24_bulk_tx_poll(nrf24_bulk_tx_t *tx, uint32_t now_ms)
+{
+    nrf24_t *nrf24 = tx->nrf24;
+    nrf24_fifosta_t fifosta;
+    int result;
+    int n = 0;
+
+    if (tx->state != NRF24_BULK_RUNNING) {
+        return 0;
+    }
+
+    result = nrf24_status_routine(nrf24, nrf24_read_and_clear_status(nrf24));
+
+    if (result & NRF24_STA_TX_FAIL) {
+        /* the flushed frames are reported missing by the next status */
+        tx->stats.max_rt++;
+        nrf24_txfifo_flush(nrf24);
+        nrf24_clear_txfail_flag(nrf24);
+    }
+
+    /* ACK payloads (TX_FAIL hides RX_DR, check the FIFO too) */
+    if (result != NRF24_STA_NONE) {
+        uint8_t buf[32];
+        uint8_t len;
+        uint8_t pipe;
+
+        while (nrf24_rxfifo_has_data(nrf24)) {
+            if (nrf24_rxfifo_read(nrf24, buf, &len, &pipe) != 0) {
+                break;
+            }
+            tx_status(tx, buf, len);
+        }
+        if (tx->state != NRF24_BULK_RUNNING) {
+            return 0;
+        }
+    }
+
+    for (;;) {
+        fifosta = nrf24_read_fifosta(nrf24);
+        if (fifosta.tx_full || !tx_next(tx, fifosta, now_ms)) {
+            break;
+        }
+        n++;
+    }
+
+    return n;
+}
+
+/****************/
+/*   Receiver   */
+/****************/
+
+/**
+ * @brief Initialize a receiver (no I/O); the radio must be set up as PRX
+ * with ACK payloads enabled.
+ *
+ * @param bitmap        Storage for the block bitmap (`NRF24_BULK_BITMAP_BYTES()` of the largest transfer).
+ * @param write         Data sink.
+ * @param save          Persists state and bitmap, or NULL.
+ * @return 0 on success.
+ */
+int nrf24_bulk_rx_init(nrf24_bulk_rx_t *rx, nrf24_t *nrf24, uint8_t *bitmap, uint16_t bitmap_bytes, nrf24_bulk_write_t write, nrf24_bulk_save_t save, void *ctx)
+{
+    CHECK(rx != 0 && nrf24 != 0 && bitmap != 0 && bitmap_bytes > 0 && write != 0);
+
+    rx->nrf24 = nrf24;
+    rx->bitmap = bitmap;
+    rx->bitmap_bytes = bitmap_bytes;
+    rx->write = write;
+    rx->save = save;
+    rx->ctx = ctx;
+    rx->save_every = 64;
+
+    rx->info.id = 0;
+    rx->info.blocks = 0;
+    rx->info.size = 0;
+    rx->info.received = 0;
+    rx->is_rejected = 0;
+    rx->unsaved = 0;
+
+    rx->stats.blocks = 0;
+    rx->stats.duplicates = 0;
+    rx->stats.polls = 0;
+    rx->stats.saves = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Continue a saved transfer; `rx->bitmap` must hold the saved bitmap.
+ *
+ * @return 0 on success.
+ */
+int nrf24_bulk_rx_resume(nrf24_bulk_rx_t *rx, const nrf24_bulk_rx_info_t *info)
+{
+    CHECK(info != 0 && (uint32_t)(info->blocks + 7) / 8 <= rx->bitmap_bytes);
+
+    rx->info = *info;
+    rx->is_rejected = 0;
+    rx->unsaved = 0;
+
+    return 0;
+}
+
+static void rx_save(nrf24_bulk_rx_t *rx)
+{
+    rx->unsaved = 0;
+    if (rx->save != 0) {
+        rx->save(rx->ctx, &rx->info, rx->bitmap, (uint16_t)((rx->info.blocks + 7) / 8));
+        rx->stats.saves++;
+    }
+}
+
+static int is_received(const nrf24_bulk_rx_t *rx, uint32_t block)
+{
+    return rx->bitmap[block >> 3] & (1 << (block & 7));
+}
+
+static void rx_start(nrf24_bulk_rx_t *rx, const uint8_t *buf, uint8_t len)
+{
+    uint16_t id;
+    uint16_t blocks;
+
+    if (len < 9) {
+        return;
+    }
+    id = get16(buf + 1);
+    blocks = get16(buf + 3);
+
+    if (!rx->is_rejected && rx->info.blocks != 0 && rx->info.id == id && rx->info.blocks == blocks) {
+        return; // resume
+    }
+
+    rx->info.id = id;
+    rx->info.size = get32(buf + 5);
+    rx->info.received = 0;
+    if (blocks == 0 || (uint32_t)(blocks + 7) / 8 > rx->bitmap_bytes) {
+        rx->info.blocks = 0;
+        rx->is_rejected = 1;
+        return;
+    }
+    rx->info.blocks = blocks;
+    rx->is_rejected = 0;
+
+    for (int i = 0; i < (blocks + 7) / 8; i++) {
+        rx->bitmap[i] = 0;
+    }
+    rx_save(rx);
+}
+
+static void rx_data(nrf24_bulk_rx_t *rx, const uint8_t *buf, uint8_t len)
+{
+    uint16_t block;
+
+    if (len < 4 || rx->info.blocks == 0) {
+        return;
+    }
+    block = get16(buf + 1);
+    if (block >= rx->info.blocks) {
+        return;
+    }
+    if (is_received(rx, block)) {
+        rx->stats.duplicates++;
+        return;
+    }
+    if (rx->write(rx->ctx, (uint32_t)block * NRF24_BULK_BLOCK, buf + 3, len - 3) != 0) {
+        return; // stays missing, asked for again
+    }
+
+    rx->bitmap[block >> 3] |= 1 << (block & 7);
+    rx->info.received++;
+    rx->stats.blocks++;
+
+    if (++rx->unsaved >= rx->save_every || rx->info.received == rx->info.blocks) {
+        rx_save(rx);
+    }
+}
+
+/**
+ * @brief Encode the first missing ranges as `n x (first LE16, count LE16)`.
+ *
+ * @param[out] out  Room for NRF24_BULK_RANGES ranges.
+ * @return Number of ranges (0: nothing missing).
+ */
+static uint8_t missing_ranges(const nrf24_bulk_rx_t *rx, uint8_t *out)
+{
+    uint32_t block = 0;
+    uint8_t n = 0;
+
+    while (block < rx->info.blocks && n < NRF24_BULK_RANGES) {
+        uint32_t first;
+
+        if (rx->bitmap[block >> 3] == 0xFF && (block & 7) == 0) {
+            block += 8;
+            continue;
+        }
+        if (is_received(rx, block)) {
+            block++;
+            continue;
+        }
+        first = block;
+        while (block < rx->info.blocks && !is_received(rx, block)) {
+            block++;
+        }
+        put16(out + 4 * n, (uint16_t)first);
+        put16(out + 2 + 4 * n, (uint16_t)(block - first));
+        n++;
+    }
+
+    return n;
+}
+
+/// Answer a poll with the first missing ranges (sent with the next ACK)
+static void rx_poll(nrf24_bulk_rx_t *rx, const uint8_t *buf, uint8_t len, uint8_t pipe)
+{
+    nrf24_t *nrf24 = rx->nrf24;
+    uint8_t status[32];
+    uint8_t n = 0;
+
+    if (len < 4) {
+        return;
+    }
+    rx->stats.polls++;
+
+    status[0] = FRAME_STATUS;
+    status[1] = buf[1];
+
+    if (get16(buf + 2) != rx->info.id || (rx->info.blocks == 0 && !rx->is_rejected)) {
+        n = NRF24_BULK_NEED_START;
+    } else if (rx->is_rejected) {
+        n = NRF24_BULK_REJECTED;
+    } else {
+        n = missing_ranges(rx, status + 3);
+    }
+    status[2] = n;
+
+    /* only the latest answer is worth sending */
+    nrf24_txfifo_flush(nrf24);
+    nrf24_txfifo_prx_write(nrf24, status, n > NRF24_BULK_RANGES ? 3 : 3 + 4 * n, pipe);
+}
+
+/**
+ * @brief Store received blocks and answer polls; call often.
+ *
+ * @return Number of frames processed.
+ */
+int nrf24_bulk_rx_poll(nrf24_bulk_rx_t *rx)
+{
+    nrf24_t *nrf24 = rx->nrf24;
+    uint8_t buf[32];
+    uint8_t len;
+    uint8_t pipe;
+    int n = 0;
+
+    nrf24_read_and_clear_status(nrf24);
+
+    while (nrf24_rxfifo_has_data(nrf24)) {
+        if (nrf24_rxfifo_read(nrf24, buf, &len, &pipe) != 0 || len == 0) {
+            break;
+        }
+
+        switch (buf[0]) {
+        case FRAME_START:
+            rx_start(rx, buf, len);
+            break;
+        case FRAME_DATA:
+            rx_data(rx, buf, len);
+            break;
+        case FRAME_POLL:
+            rx_poll(rx, buf, len, pipe);
+            break;
+        default:
+            break;
+        }
+        n++;
+    }
+
+    return n;
+}
+
+/// 1 once every block of the current transfer is stored.
+int nrf24_bulk_rx_is_complete(const nrf24_bulk_rx_t *rx)
+{
+    return rx->info.blocks != 0 && rx->info.received == rx->info.blocks;
+}
@@ -0,0 +1,151 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_BULK_H
+#define NRF24L01_BULK_H
+
+#include "nrf24l01.h"
+
+/* Resumable bulk transfer (firmware images, log dumps)
+ *
+ * The data is split into NRF24_BULK_BLOCK byte blocks numbered 0..blocks-1.
+ * The sender (PTX, CE high) streams blocks back to back; the receiver
+ * (PRX, ACK payloads enabled) stores them and tracks a bitmap. Repair and
+ * resume use the same mechanism: the sender polls, the receiver answers
+ * (in the ACK payload of the next packet) with up to NRF24_BULK_RANGES
+ * missing ranges, the sender streams those and polls again, until the
+ * receiver reports none missing. A fresh transfer is just "everything is
+ * missing".
+ *
+ * Frames (sender -> receiver):
+ *   START  [0x01][id LE16][blocks LE16][size LE32]
+ *   DATA   [0x02][block LE16][data 1..29]
+ *   POLL   [0x03][seq][id LE16]
+ * Frames (receiver -> sender, ACK payload):
+ *   STATUS [0x81][seq][n][n x (first LE16, count LE16)]
+ *          n = 0: complete, NRF24_BULK_NEED_START, NRF24_BULK_REJECTED
+ *
+ * The receiver hands its state and bitmap to `save` every `save_every`
+ * new blocks and on completion; after a power loss, load them and call
+ * `nrf24_bulk_rx_resume()`: a START with the same id and block count keeps
+ * the bitmap and only the missing blocks are sent again.
+ */
+
+#define NRF24_BULK_BLOCK      29
+#define NRF24_BULK_RANGES     7
+#define NRF24_BULK_MAX_BLOCKS 0xFFFFu
+
+#define NRF24_BULK_NEED_START 0xFE
+#define NRF24_BULK_REJECTED   0xFF
+
+/* Bytes of bitmap needed for `size` bytes of data */
+#define NRF24_BULK_BITMAP_BYTES(size) ((((size) + NRF24_BULK_BLOCK - 1) / NRF24_BULK_BLOCK + 7) / 8)
+
+typedef enum {
+    NRF24_BULK_IDLE = 0,
+    NRF24_BULK_RUNNING = 1,
+    NRF24_BULK_DONE = 2,
+    NRF24_BULK_FAILED = 3,  // receiver rejected (bitmap too small) or source read error
+} nrf24_bulk_state_t;
+
+/**************/
+/*   Sender   */
+/**************/
+
+// read `len` bytes at `offset` of the data; return 0 on success
+typedef int (*nrf24_bulk_read_t)(void *ctx, uint32_t offset, uint8_t *buf, uint8_t len);
+
+typedef struct {
+    uint16_t first;
+    uint16_t count;
+} nrf24_bulk_range_t;
+
+typedef struct {
+    uint32_t blocks;            // DATA frames written
+    uint32_t polls;
+    uint32_t statuses;          // status answers accepted
+    uint32_t max_rt;
+} nrf24_bulk_tx_stats_t;
+
+typedef struct {
+    nrf24_t *nrf24;
+    nrf24_bulk_read_t read;
+    void *ctx;
+    uint16_t id;
+    uint16_t blocks;
+    uint32_t size;
+
+    // parameters (defaults set by `nrf24_bulk_tx_init()`)
+    uint32_t poll_interval_ms;  // min time between polls while waiting for a status, default 1
+
+    // state
+    nrf24_bulk_state_t state;
+    uint8_t need_start;
+    uint8_t seq;
+    uint8_t num_ranges;
+    uint8_t range_idx;
+    uint32_t cursor;            // next block of ranges[range_idx]
+    uint32_t last_poll_ms;
+    nrf24_bulk_range_t ranges[NRF24_BULK_RANGES];
+
+    nrf24_bulk_tx_stats_t stats;
+} nrf24_bulk_tx_t;
+
+int nrf24_bulk_tx_init(nrf24_bulk_tx_t *tx, nrf24_t *nrf24, uint16_t id, uint32_t size, nrf24_bulk_read_t read, void *ctx);
+int nrf24_bulk_tx_poll(nrf24_bulk_tx_t *tx, uint32_t now_ms);
+
+/****************/
+/*   Receiver   */
+/****************/
+
+typedef struct {
+    uint16_t id;
+    uint16_t blocks;            // 0: no transfer
+    uint32_t size;
+    uint16_t received;
+} nrf24_bulk_rx_info_t;
+
+// store `len` bytes at `offset`; return 0 on success (the block is then marked received)
+typedef int (*nrf24_bulk_write_t)(void *ctx, uint32_t offset, const uint8_t *data, uint8_t len);
+// persist `info` and the bitmap (optional)
+typedef void (*nrf24_bulk_save_t)(void *ctx, const nrf24_bulk_rx_info_t *info, const uint8_t *bitmap, uint16_t bytes);
+
+typedef struct {
+    uint32_t blocks;            // new blocks stored
+    uint32_t duplicates;
+    uint32_t polls;
+    uint32_t saves;
+} nrf24_bulk_rx_stats_t;
+
+typedef struct {
+    nrf24_t *nrf24;
+    uint8_t *bitmap;
+    uint16_t bitmap_bytes;
+    nrf24_bulk_write_t write;
+    nrf24_bulk_save_t save;
+    void *ctx;
+
+    // parameters (defaults set by `nrf24_bulk_rx_init()`)
+    uint16_t save_every;        // new blocks between saves, default 64
+
+    // state
+    nrf24_bulk_rx_info_t info;
+    uint8_t is_rejected;
+    uint16_t unsaved;
+
+    nrf24_bulk_rx_stats_t stats;
+} nrf24_bulk_rx_t;
+
+int nrf24_bulk_rx_init(nrf24_bulk_rx_t *rx, nrf24_t *nrf24, uint8_t *bitmap, uint16_t bitmap_bytes, nrf24_bulk_write_t write, nrf24_bulk_save_t save, void *ctx);
+int nrf24_bulk_rx_resume(nrf24_bulk_rx_t *rx, const nrf24_bulk_rx_info_t *info);
+int nrf24_bulk_rx_poll(nrf24_bulk_rx_t *rx);
+int nrf24_bulk_rx_is_complete(const nrf24_bulk_rx_t *rx);
+
+#endif // NRF24L01_BULK_H
@@ -0,0 +1,385 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_bus.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+/*****************/
+/* Wrapped dep ops (ctx is the member) */
+/*****************/
+
+#define MEMBER(ctx) ((nrf24_bus_member_t *)(ctx))
+
+static inline uint32_t bus_now(const nrf24_bus_t *bus)
+{
+    return bus->now_us != 0 ? bus->now_us() : 0;
+}
+
+static inline void account(nrf24_bus_member_t *m, uint32_t t0, uint32_t bytes)
+{
+    m->stats.bus_us += bus_now(m->bus) - t0;
+    m->stats.txns++;
+    m->stats.bytes += bytes;
+}
+
+static int w_init(void *ctx)
+{
+    nrf24_bus_member_t *m = MEMBER(ctx);
+    return m->orig_ops->init != 0 ? m->orig_ops->init(m->orig_ctx) : 0;
+}
+
+static void w_deinit(void *ctx)
+{
+    nrf24_bus_member_t *m = MEMBER(ctx);
+    if (m->orig_ops->deinit != 0) {
+        m->orig_ops->deinit(m->orig_ctx);
+    }
+}
+
+static int w_spi_send(void *ctx, const uint8_t *buf, uint8_t len)
+{
+    nrf24_bus_member_t *m = MEMBER(ctx);
+    uint32_t t0 = bus_now(m->bus);
+    int ret = m->orig_ops->spi_send(m->orig_ctx, buf, len);
+    account(m, t0, len);
+    return ret;
+}
+
+static int w_spi_send_then_send(void *ctx, const uint8_t *buf1, uint8_t len1, const uint8_t *buf2, uint8_t len2)
+{
+    nrf24_bus_member_t *m = MEMBER(ctx);
+    uint32_t t0 = bus_now(m->bus);
+    int ret = m->orig_ops->spi_send_then_send(m->orig_ctx, buf1, len1, buf2, len2);
+    account(m, t0, len1 + len2);
+    return ret;
+}
+
+static int w_spi_send_then_recv(void *ctx, const uint8_t *wbuf, uint8_t wlen, uint8_t *rbuf, uint8_t rlen)
+{
+    nrf24_bus_member_t *m = MEMBER(ctx);
+    uint32_t t0 = bus_now(m->bus);
+    int ret = m->orig_ops->spi_send_then_recv(m->orig_ctx, wbuf, wlen, rbuf, rlen);
+    account(m, t0, wlen + rlen);
+    return ret;
+}
+
+static void w_set_ce_low(void *ctx)
+{
+    nrf24_bus_member_t *m = MEMBER(ctx);
+    m->orig_ops->set_ce_low(m->orig_ctx);
+}
+
+static void w_set_ce_high(void *ctx)
+{
+    nrf24_bus_member_t *m = MEMBER(ctx);
+    m->orig_ops->set_ce_high(m->orig_ctx);
+}
+
+#ifdef NRF24L01_ENABLE_LOCK
+static void w_lock(void *ctx)
+{
+    nrf24_bus_member_t *m = MEMBER(ctx);
+    if (m->orig_ops->lock != 0) {
+        m->orig_ops->lock(m->orig_ctx);
+    }
+}
+
+static void w_unlock(void *ctx)
+{
+    nrf24_bus_member_t *m = MEMBER(ctx);
+    if (m->orig_ops->unlock != 0) {
+        m->orig_ops->unlock(m->orig_ctx);
+    }
+}
+#endif
+
+static nrf24_dep_ops_t g_bus_member_ops = {
+    .init = w_init,
+    .deinit = w_deinit,
+    .spi_send = w_spi_send,
+    .spi_send_then_send = w_spi_send_then_send,
+    .spi_send_then_recv = w_spi_send_then_recv,
+    .set_ce_low = w_set_ce_low,
+    .set_ce_high = w_set_ce_high,
+#ifdef NRF24L01_ENABLE_LOCK
+    .lock = w_lock,
+    .unlock = w_unlock,
+#endif
+};
+
+/*****************/
+/* Manager */
+/*****************/
+
+/**
+ * @brief Initialize a bus manager.
+ *
+ * @param members   Caller-provided storage, one per radio.
+ * @param num       Number of radios (1-32).
+ * @param jobs      Caller-provided job queue storage.
+ * @param num_jobs  Job queue capacity.
+ * @return 0 on success.
+ *
+ * @note Set the optional `now_us`, `on_rx`, `on_event` and `notify` fields afterwards.
+ */
+int nrf24_bus_init(nrf24_bus_t *bus, nrf24_bus_member_t *members, uint8_t num, nrf24_bus_job_t *jobs, uint16_t num_jobs)
+{
+    CHECK(bus != 0 && members != 0 && num > 0 && num <= 32);
+    CHECK(jobs != 0 || num_jobs == 0);
+
+    bus->members = members;
+    bus->num = num;
+    bus->rr = 0;
+    bus->jobs = jobs;
+    bus->num_jobs = num_jobs;
+    bus->seq = 0;
+    bus->now_us = 0;
+    bus->on_rx = 0;
+    bus->on_event = 0;
+    bus->notify = 0;
+    bus->user_data = 0;
+
+    for (int i = 0; i < num; i++) {
+        members[i].nrf24 = 0;
+        members[i].bus = bus;
+        members[i].irq_pending = 0;
+        nrf24_bus_stats_reset(bus, i);
+    }
+
+    for (int i = 0; i < num_jobs; i++) {
+        jobs[i].used = 0;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Put an initialized instance (see `nrf24_init()`) under the manager.
+ *
+ * The instance's dep ops are wrapped for accounting; the instance itself can
+ * still be set up as usual, but should only be accessed from the service loop
+ * (jobs and callbacks) afterwards.
+ */
+int nrf24_bus_attach(nrf24_bus_t *bus, uint8_t idx, nrf24_t *nrf24)
+{
+    nrf24_bus_member_t *m;
+
+    CHECK(idx < bus->num && nrf24 != 0);
+
+    m = &bus->members[idx];
+    CHECK(m->nrf24 == 0);
+
+    m->nrf24 = nrf24;
+    m->orig_ops = nrf24->dep.ops;
+    m->orig_ctx = nrf24->dep.ctx;
+    m->irq_pending = 0;
+
+    nrf24->dep.ops = &g_bus_member_ops;
+    nrf24->dep.ctx = m;
+
+    return 0;
+}
+
+/**
+ * @brief Release an instance (restores its dep ops, drops its queued jobs).
+ */
+void nrf24_bus_detach(nrf24_bus_t *bus, uint8_t idx)
+{
+    nrf24_bus_member_t *m = &bus->members[idx];
+
+    if (m->nrf24 == 0) {
+        return;
+    }
+
+    m->nrf24->dep.ops = m->orig_ops;
+    m->nrf24->dep.ctx = m->orig_ctx;
+    m->nrf24 = 0;
+
+    for (int i = 0; i < bus->num_jobs; i++) {
+        if (bus->jobs[i].used && bus->jobs[i].idx == idx) {
+            bus->jobs[i].used = 0;
+        }
+    }
+}
+
+/**
+ * @brief Mark a radio's IRQ as pending.
+ *
+ * @note ISR-safe (no I/O), call from the IRQ pin handler.
+ */
+void nrf24_bus_irq(nrf24_bus_t *bus, uint8_t idx)
+{
+    bus->members[idx].irq_pending = 1;
+
+    if (bus->notify != 0) {
+        bus->notify(bus);
+    }
+}
+
+/**
+ * @brief Queue a job for a radio.
+ *
+ * @param idx   Attached member index.
+ * @param prio  `NRF24_BUS_PRIO_xxx` (lower is more urgent).
+ * @return 0 on success, `NRF24_ERR_BUSY` if the job queue is full.
+ *
+ * @note Not ISR-safe; call from the service loop thread (e.g. from callbacks or jobs).
+ */
+int nrf24_bus_submit(nrf24_bus_t *bus, uint8_t idx, uint8_t prio, nrf24_bus_job_fn_t fn, void *arg)
+{
+    CHECK(idx < bus->num && fn != 0);
+    CHECK(bus->members[idx].nrf24 != 0);
+
+    for (int i = 0; i < bus->num_jobs; i++) {
+        nrf24_bus_job_t *j = &bus->jobs[i];
+        if (j->used) {
+            continue;
+        }
+
+        j->fn = fn;
+        j->arg = arg;
+        j->idx = idx;
+        j->prio = prio;
+        j->seq = bus->seq++;
+        j->t_submit = bus_now(bus);
+        j->used = 1;
+
+        if (bus->notify != 0) {
+            bus->notify(bus);
+        }
+        return 0;
+    }
+
+    return NRF24_ERR_BUSY;
+}
+
+/// @return number of handled events
+static int service_irq(nrf24_bus_t *bus, uint8_t idx)
+{
+    nrf24_bus_member_t *m = &bus->members[idx];
+    nrf24_t *nrf24 = m->nrf24;
+    uint8_t buf[32];
+    uint8_t len;
+    uint8_t pipe;
+    int result;
+    int n = 0;
+
+    m->stats.irqs++;
+
+    result = nrf24_status_routine(nrf24, nrf24_read_and_clear_status(nrf24));
+
+    if (result & NRF24_STA_HAS_RXDATA) {
+        while (nrf24_rxfifo_has_data(nrf24)) {
+            if (nrf24_rxfifo_read(nrf24, buf, &len, &pipe) != 0) {
+                break;
+            }
+            m->stats.rx_pkts++;
+            n++;
+            if (bus->on_rx != 0) {
+                bus->on_rx(bus, idx, buf, len, pipe);
+            }
+        }
+    }
+
+    if ((result & (NRF24_STA_TX_SENT | NRF24_STA_TX_FAIL)) && bus->on_event != 0) {
+        bus->on_event(bus, idx, result & (NRF24_STA_TX_SENT | NRF24_STA_TX_FAIL));
+        n++;
+    }
+
+    return n;
+}
+
+/// @return index of the most urgent (then oldest) job, -1 if none
+static int pick_job(const nrf24_bus_t *bus)
+{
+    int best = -1;
+
+    for (int i = 0; i < bus->num_jobs; i++) {
+        const nrf24_bus_job_t *j = &bus->jobs[i];
+        if (!j->used) {
+            continue;
+        }
+        if (best < 0 || j->prio < bus->jobs[best].prio
+            || (j->prio == bus->jobs[best].prio && (int32_t)(j->seq - bus->jobs[best].seq) < 0)) {
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Run one service iteration.
+ *
+ * Services every pending IRQ (status, RX drain, TX result), starting from a
+ * rotating radio so none is starved, then runs at most one job, so pending
+ * IRQs are looked at again before the next job.
+ *
+ * @return Amount of work done (0: idle, the caller may wait for `notify`).
+ */
+int nrf24_bus_poll(nrf24_bus_t *bus)
+{
+    int n = 0;
+    int k;
+
+    for (int i = 0; i < bus->num; i++) {
+        uint8_t idx = (bus->rr + i) % bus->num;
+        nrf24_bus_member_t *m = &bus->members[idx];
+
+        if (m->nrf24 == 0 || !m->irq_pending) {
+            continue;
+        }
+
+        m->irq_pending = 0;
+        n += 1 + service_irq(bus, idx);
+    }
+    bus->rr = (bus->rr + 1) % bus->num;
+
+    k = pick_job(bus);
+    if (k >= 0) {
+        nrf24_bus_job_t *j = &bus->jobs[k];
+        nrf24_bus_member_t *m = &bus->members[j->idx];
+        uint32_t wait = bus_now(bus) - j->t_submit;
+
+        j->used = 0;
+        if (wait > m->stats.job_wait_max_us) {
+            m->stats.job_wait_max_us = wait;
+        }
+        m->stats.jobs++;
+        j->fn(m->nrf24, j->arg);
+        n++;
+    }
+
+    return n;
+}
+
+const nrf24_bus_stats_t *nrf24_bus_stats(const nrf24_bus_t *bus, uint8_t idx)
+{
+    return &bus->members[idx].stats;
+}
+
+void nrf24_bus_stats_reset(nrf24_bus_t *bus, uint8_t idx)
+{
+    nrf24_bus_stats_t *s = &bus->members[idx].stats;
+
+    s->bus_us = 0;
+    s->txns = 0;
+    s->bytes = 0;
+    s->irqs = 0;
+    s->rx_pkts = 0;
+    s->jobs = 0;
+    s->job_wait_max_us = 0;
+}
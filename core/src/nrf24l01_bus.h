@@ -0,0 +1,94 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_BUS_H
+#define NRF24L01_BUS_H
+
+#include "nrf24l01.h"
+
+/* Multi-radio bus manager
+ *
+ * Owns several instances sharing one SPI bus. All device access goes through
+ * one service loop (`nrf24_bus_poll()`), which arbitrates by priority:
+ * pending IRQs (RX drain) first, then queued jobs, most urgent first. The dep
+ * ops of attached instances are wrapped to account bus time per radio.
+ */
+
+/* Job priorities (lower is more urgent) */
+#define NRF24_BUS_PRIO_HIGH   0
+#define NRF24_BUS_PRIO_TX     1
+#define NRF24_BUS_PRIO_NORMAL 2
+#define NRF24_BUS_PRIO_CFG    3
+
+typedef struct nrf24_bus nrf24_bus_t;
+
+/* Received packet, `data` is only valid during the call */
+typedef void (*nrf24_bus_rx_cb_t)(nrf24_bus_t *bus, int idx, const uint8_t *data, uint8_t len, uint8_t pipe);
+/* TX result (`NRF24_STA_TX_SENT` or `NRF24_STA_TX_FAIL`); MAX_RT is left set, as with `nrf24_clear_status()` */
+typedef void (*nrf24_bus_evt_cb_t)(nrf24_bus_t *bus, int idx, nrf24_status_enum_t sta);
+/* Job body, runs in the service loop with exclusive bus access */
+typedef int (*nrf24_bus_job_fn_t)(nrf24_t *nrf24, void *arg);
+
+typedef struct {
+    uint32_t bus_us;          // time spent in SPI transfers (needs `now_us`)
+    uint32_t txns;            // SPI transactions
+    uint32_t bytes;           // SPI bytes (command included)
+    uint32_t irqs;            // serviced IRQs
+    uint32_t rx_pkts;         // drained packets
+    uint32_t jobs;            // executed jobs
+    uint32_t job_wait_max_us; // max submit-to-run latency (needs `now_us`)
+} nrf24_bus_stats_t;
+
+typedef struct {
+    nrf24_t *nrf24;
+    nrf24_bus_t *bus;
+    nrf24_dep_ops_t *orig_ops;
+    void *orig_ctx;
+    volatile uint8_t irq_pending;
+    nrf24_bus_stats_t stats;
+} nrf24_bus_member_t;
+
+typedef struct {
+    nrf24_bus_job_fn_t fn;
+    void *arg;
+    uint32_t seq;
+    uint32_t t_submit;
+    uint8_t idx;
+    uint8_t prio;
+    uint8_t used;
+} nrf24_bus_job_t;
+
+struct nrf24_bus {
+    nrf24_bus_member_t *members;
+    uint8_t num;
+    uint8_t rr; // round-robin start for IRQ servicing
+
+    nrf24_bus_job_t *jobs;
+    uint16_t num_jobs;
+    uint32_t seq;
+
+    // optional
+    uint32_t (*now_us)(void);
+    nrf24_bus_rx_cb_t on_rx;
+    nrf24_bus_evt_cb_t on_event;
+    void (*notify)(nrf24_bus_t *bus); // work became pending (e.g. release a semaphore)
+    void *user_data;
+};
+
+int nrf24_bus_init(nrf24_bus_t *bus, nrf24_bus_member_t *members, uint8_t num, nrf24_bus_job_t *jobs, uint16_t num_jobs);
+int nrf24_bus_attach(nrf24_bus_t *bus, uint8_t idx, nrf24_t *nrf24);
+void nrf24_bus_detach(nrf24_bus_t *bus, uint8_t idx);
+void nrf24_bus_irq(nrf24_bus_t *bus, uint8_t idx);
+int nrf24_bus_submit(nrf24_bus_t *bus, uint8_t idx, uint8_t prio, nrf24_bus_job_fn_t fn, void *arg);
+int nrf24_bus_poll(nrf24_bus_t *bus);
+const nrf24_bus_stats_t *nrf24_bus_stats(const nrf24_bus_t *bus, uint8_t idx);
+void nrf24_bus_stats_reset(nrf24_bus_t *bus, uint8_t idx);
+
+#endif // NRF24L01_BUS_H
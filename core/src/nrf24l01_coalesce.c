@@ -0,0 +1,231 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_coalesce.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+/**
+ * @brief Initialize a coalescer (no I/O).
+ *
+ * @param deadline_ms  Max time a message is held back waiting for others (0: flush on every poll).
+ * @return 0 on success.
+ */
+int nrf24_coalesce_init(nrf24_coalesce_t *c, nrf24_t *nrf24, uint32_t deadline_ms)
+{
+    CHECK(c != 0 && nrf24 != 0);
+
+    c->nrf24 = nrf24;
+    c->deadline_ms = deadline_ms;
+    c->frame_size = 32;
+    c->no_ack = 0;
+    c->pad = 0;
+
+    c->len = 0;
+    c->count = 0;
+    c->first_ms = 0;
+
+    c->stats.msgs = 0;
+    c->stats.frames = 0;
+    c->stats.full_flushes = 0;
+    c->stats.deadline_flushes = 0;
+    c->stats.push_flushes = 0;
+    c->stats.busy = 0;
+
+    return 0;
+}
+
+/// Write the frame to the TX FIFO; keeps it on NRF24_ERR_BUSY or I/O error
+static int flush(nrf24_coalesce_t *c)
+{
+    nrf24_t *nrf24 = c->nrf24;
+    uint8_t len = c->len;
+    int ret;
+
+    if (c->len == 0) {
+        return 0;
+    }
+
+    if (!nrf24_txfifo_has_space(nrf24)) {
+        c->stats.busy++;
+        return NRF24_ERR_BUSY;
+    }
+
+    if (c->pad) {
+        // a zero length byte ends the frame on the receive side
+        for (; len < c->frame_size; len++) {
+            c->buf[len] = 0;
+        }
+    }
+
+    if (c->no_ack && nrf24->role == NRF24_ROLE_PTX) {
+        ret = nrf24_txfifo_ptx_write_no_ack(nrf24, c->buf, len);
+    } else {
+        ret = nrf24_txfifo_write(nrf24, c->buf, len);
+    }
+    if (ret != 0) {
+        return ret;
+    }
+
+    c->stats.frames++;
+    c->len = 0;
+    c->count = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Queue a message for the next frame.
+ *
+ * A frame that cannot take the message is written out first; a frame that
+ * cannot take any further message is written out right away.
+ *
+ * @param len  1..NRF24_COALESCE_MAX_MSG, and at most `frame_size - 1`.
+ * @return 0 on success (message taken), NRF24_ERR_BUSY if the pending frame
+ *         could not be written (TX FIFO full, message not taken).
+ */
+int nrf24_coalesce_put(nrf24_coalesce_t *c, const uint8_t *data, uint8_t len, uint32_t now_ms)
+{
+    int ret;
+
+    CHECK(data != 0 && len > 0 && len <= NRF24_COALESCE_MAX_MSG && len < c->frame_size);
+
+    if (c->len + 1 + len > c->frame_size) {
+        ret = flush(c);
+        if (ret != 0) {
+            return ret;
+        }
+        c->stats.full_flushes++;
+    }
+
+    if (c->count == 0) {
+        c->first_ms = now_ms;
+    }
+    c->buf[c->len++] = len;
+    for (int i = 0; i < len; i++) {
+        c->buf[c->len++] = data[i];
+    }
+    c->count++;
+    c->stats.msgs++;
+
+    /* no room for even a 1 byte message */
+    if (c->len + 2 > c->frame_size) {
+        if (flush(c) == 0) {
+            c->stats.full_flushes++;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Write the pending frame now.
+ *
+ * @return 0 on success or nothing pending, NRF24_ERR_BUSY if the TX FIFO is full.
+ */
+int nrf24_coalesce_push(nrf24_coalesce_t *c)
+{
+    int ret;
+
+    if (c->len == 0) {
+        return 0;
+    }
+
+    ret = flush(c);
+    if (ret == 0) {
+        c->stats.push_flushes++;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Write the pending frame once its deadline expired; call often.
+ *
+ * Also retries a frame whose flush was deferred by a full TX FIFO.
+ *
+ * @return 1 if a frame was written, 0 otherwise.
+ */
+int nrf24_coalesce_poll(nrf24_coalesce_t *c, uint32_t now_ms)
+{
+    int is_full = c->len + 2 > c->frame_size;
+
+    if (c->len == 0) {
+        return 0;
+    }
+
+    if (!is_full && now_ms - c->first_ms < c->deadline_ms) {
+        return 0;
+    }
+
+    if (flush(c) != 0) {
+        return 0;
+    }
+    if (is_full) {
+        c->stats.full_flushes++;
+    } else {
+        c->stats.deadline_flushes++;
+    }
+
+    return 1;
+}
+
+/// Number of messages waiting in the pending frame.
+uint8_t nrf24_coalesce_pending(const nrf24_coalesce_t *c)
+{
+    return c->count;
+}
+
+/**
+ * @brief Start walking the messages of a received packet.
+ *
+ * @param pkt  Packet data; must stay valid while the views are used.
+ */
+void nrf24_decoalesce_begin(nrf24_decoalesce_t *it, const uint8_t *pkt, uint8_t len)
+{
+    it->p = pkt;
+    it->left = len;
+}
+
+/**
+ * @brief Get the next message of the packet as a view into it.
+ *
+ * @param[out] msg  Points into the packet passed to `nrf24_decoalesce_begin()`.
+ * @param[out] len  Message length.
+ * @return 1 if a message was returned, 0 at the end of the packet,
+ *         -1 if the packet is malformed (a length runs past its end).
+ */
+int nrf24_decoalesce_next(nrf24_decoalesce_t *it, const uint8_t **msg, uint8_t *len)
+{
+    uint8_t n;
+
+    if (it->left == 0 || it->p[0] == 0) {
+        it->left = 0;
+        return 0;
+    }
+
+    n = it->p[0];
+    if (n >= it->left) {
+        it->left = 0;
+        return -1;
+    }
+
+    *msg = it->p + 1;
+    *len = n;
+    it->p += 1 + n;
+    it->left -= 1 + n;
+
+    return 1;
+}
@@ -0,0 +1,76 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_COALESCE_H
+#define NRF24L01_COALESCE_H
+
+#include "nrf24l01.h"
+
+/* Message coalescing (Nagle-style)
+ *
+ * Small application messages are packed into one frame instead of paying
+ * the per-packet overhead (preamble, address, CRC, ACK) for each of them.
+ * Frame format: `[len][data...][len][data...]...`, `len` 1..31; a zero
+ * length byte or the end of the packet ends the frame. With static payload
+ * widths set `frame_size` to the width and `pad`: frames are zero-padded to it.
+ *
+ * A frame is written to the TX FIFO when:
+ * - the next message does not fit, or no further message can fit,
+ * - the oldest message in it has waited `deadline_ms` (`nrf24_coalesce_poll()`),
+ * - `nrf24_coalesce_push()` is called.
+ *
+ * On the receive side `nrf24_decoalesce_next()` walks a packet and returns
+ * views into it; nothing is copied.
+ */
+
+#define NRF24_COALESCE_MAX_MSG 31
+
+typedef struct {
+    uint32_t msgs;
+    uint32_t frames;
+    uint32_t full_flushes;      // frame could take no further message
+    uint32_t deadline_flushes;
+    uint32_t push_flushes;
+    uint32_t busy;              // flush deferred, TX FIFO full
+} nrf24_coalesce_stats_t;
+
+typedef struct {
+    nrf24_t *nrf24;
+
+    // parameters (defaults set by `nrf24_coalesce_init()`)
+    uint32_t deadline_ms;       // max time a message waits for company
+    uint8_t frame_size;         // <= 32, default 32 (set to the static payload width if used)
+    uint8_t no_ack;             // PTX: write frames with W_TX_PAYLOAD_NOACK
+    uint8_t pad;                // zero-pad frames to `frame_size` (static payload width)
+
+    // state
+    uint8_t buf[32];
+    uint8_t len;
+    uint8_t count;
+    uint32_t first_ms;          // time the oldest message in `buf` was put
+
+    nrf24_coalesce_stats_t stats;
+} nrf24_coalesce_t;
+
+typedef struct {
+    const uint8_t *p;
+    uint8_t left;
+} nrf24_decoalesce_t;
+
+int nrf24_coalesce_init(nrf24_coalesce_t *c, nrf24_t *nrf24, uint32_t deadline_ms);
+int nrf24_coalesce_put(nrf24_coalesce_t *c, const uint8_t *data, uint8_t len, uint32_t now_ms);
+int nrf24_coalesce_push(nrf24_coalesce_t *c);
+int nrf24_coalesce_poll(nrf24_coalesce_t *c, uint32_t now_ms);
+uint8_t nrf24_coalesce_pending(const nrf24_coalesce_t *c);
+
+void nrf24_decoalesce_begin(nrf24_decoalesce_t *it, const uint8_t *pkt, uint8_t len);
+int nrf24_decoalesce_next(nrf24_decoalesce_t *it, const uint8_t **msg, uint8_t *len);
+
+#endif // NRF24L01_COALESCE_H
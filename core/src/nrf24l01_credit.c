@@ -0,0 +1,293 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_credit.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+#define FRAME_DATA    0x00
+#define FRAME_PROBE   0x01
+#define FRAME_ADVERT  0xC5
+
+/* more frames in flight than this means the receiver restarted */
+#define MAX_IN_FLIGHT (255 + 6)
+
+/**************/
+/*   Sender   */
+/**************/
+
+/**
+ * @brief Initialize a sender (no I/O); the radio must be set up as PTX
+ * with ACK payloads enabled and be on (CE high).
+ *
+ * @param initial_credits  Frames the receiver can take before its first advert
+ *                         (must match `nrf24_credit_rx_init()`).
+ * @return 0 on success.
+ */
+int nrf24_credit_tx_init(nrf24_credit_tx_t *tx, nrf24_t *nrf24, uint8_t initial_credits)
+{
+    CHECK(tx != 0 && nrf24 != 0);
+
+    tx->nrf24 = nrf24;
+    tx->probe_interval_ms = 2;
+
+    tx->sent = 0;
+    tx->rx_count = 0;
+    tx->free = initial_credits;
+    tx->is_stalled = 0;
+    tx->stall_since_ms = 0;
+    tx->last_probe_ms = 0;
+
+    tx->stats.frames = 0;
+    tx->stats.probes = 0;
+    tx->stats.stalls = 0;
+    tx->stats.throttled_ms = 0;
+    tx->stats.adverts = 0;
+    tx->stats.resyncs = 0;
+    tx->stats.max_rt = 0;
+
+    return 0;
+}
+
+/// Frames the receiver can still take (may be negative after a stale advert).
+int nrf24_credit_tx_credits(const nrf24_credit_tx_t *tx)
+{
+    return (int)tx->free - (uint16_t)(tx->sent - tx->rx_count);
+}
+
+/**
+ * @brief Send a frame if the receiver has room for it.
+ *
+ * @param len  1..NRF24_CREDIT_MTU.
+ * @return 0 on success, NRF24_ERR_BUSY if out of credit or the TX FIFO is full.
+ */
+int nrf24_credit_tx_send(nrf24_credit_tx_t *tx, const uint8_t *data, uint8_t len, uint32_t now_ms)
+{
+    uint8_t frame[32];
+    int ret;
+
+    CHECK(data != 0 && len > 0 && len <= NRF24_CREDIT_MTU);
+
+    if (nrf24_credit_tx_credits(tx) <= 0) {
+        if (!tx->is_stalled) {
+            tx->is_stalled = 1;
+            tx->stall_since_ms = now_ms;
+            tx->last_probe_ms = now_ms - tx->probe_interval_ms;
+            tx->stats.stalls++;
+        }
+        return NRF24_ERR_BUSY;
+    }
+
+    if (!nrf24_txfifo_has_space(tx->nrf24)) {
+        return NRF24_ERR_BUSY;
+    }
+
+    frame[0] = FRAME_DATA;
+    for (int i = 0; i < len; i++) {
+        frame[1 + i] = data[i];
+    }
+    ret = nrf24_txfifo_ptx_write(tx->nrf24, frame, len + 1);
+    if (ret != 0) {
+        return ret;
+    }
+
+    tx->sent++;
+    tx->stats.frames++;
+
+    return 0;
+}
+
+static void tx_advert(nrf24_credit_tx_t *tx, const uint8_t *buf, uint8_t len)
+{
+    uint16_t rx_count;
+
+    if (len < 4 || buf[0] != FRAME_ADVERT) {
+        return;
+    }
+    rx_count = (uint16_t)(buf[1] | (buf[2] << 8));
+
+    if ((uint16_t)(tx->sent - rx_count) > MAX_IN_FLIGHT) {
+        tx->sent = rx_count;
+        tx->stats.resyncs++;
+    }
+    tx->rx_count = rx_count;
+    tx->free = buf[3];
+    tx->stats.adverts++;
+}
+
+/**
+ * @brief Collect adverts, retry failed frames and probe while stalled; call often.
+ *
+ * Frames are never dropped on MAX_RT (the receiver already counts on them):
+ * the flag is cleared and the chip retries the head of the TX FIFO.
+ *
+ * @param now_ms  Current time.
+ * @return Current credits.
+ */
+int nrf24_credit_tx_poll(nrf24_credit_tx_t *tx, uint32_t now_ms)
+{
+    nrf24_t *nrf24 = tx->nrf24;
+    int result;
+    int credits;
+
+    result = nrf24_status_routine(nrf24, nrf24_read_and_clear_status(nrf24));
+
+    if (result & NRF24_STA_TX_FAIL) {
+        tx->stats.max_rt++;
+        nrf24_clear_txfail_flag(nrf24);
+    }
+
+    /* ACK payloads (TX_FAIL hides RX_DR, check the FIFO too) */
+    if (result != NRF24_STA_NONE) {
+        uint8_t buf[32];
+        uint8_t len;
+        uint8_t pipe;
+
+        while (nrf24_rxfifo_has_data(nrf24)) {
+            if (nrf24_rxfifo_read(nrf24, buf, &len, &pipe) != 0) {
+                break;
+            }
+            tx_advert(tx, buf, len);
+        }
+    }
+
+    credits = nrf24_credit_tx_credits(tx);
+
+    if (tx->is_stalled) {
+        if (credits > 0) {
+            tx->is_stalled = 0;
+            tx->stats.throttled_ms += now_ms - tx->stall_since_ms;
+        } else if (now_ms - tx->last_probe_ms >= tx->probe_interval_ms && nrf24_txfifo_is_empty(nrf24)) {
+            uint8_t probe = FRAME_PROBE;
+            if (nrf24_txfifo_ptx_write(nrf24, &probe, 1) == 0) {
+                tx->sent++;
+                tx->last_probe_ms = now_ms;
+                tx->stats.probes++;
+            }
+        }
+    }
+
+    return credits;
+}
+
+/****************/
+/*   Receiver   */
+/****************/
+
+/**
+ * @brief Initialize a receiver (no I/O); the radio must be set up as PRX
+ * with ACK payloads enabled.
+ *
+ * @param initial_credits  Application buffer size at start.
+ * @return 0 on success.
+ */
+int nrf24_credit_rx_init(nrf24_credit_rx_t *rx, nrf24_t *nrf24, uint8_t initial_credits)
+{
+    CHECK(rx != 0 && nrf24 != 0);
+
+    rx->nrf24 = nrf24;
+    rx->rx_count = 0;
+    rx->limit = initial_credits;
+    rx->free = initial_credits;
+    rx->is_loaded = 0;
+
+    rx->stats.frames = 0;
+    rx->stats.probes = 0;
+    rx->stats.adverts = 0;
+    rx->stats.overruns = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Read the next data frame from the RX FIFO (probes are consumed silently).
+ *
+ * Follow up with `nrf24_credit_rx_advertise()` once the frame is stored.
+ *
+ * @param[out] buf  At least NRF24_CREDIT_MTU bytes.
+ * @return 1 if a frame was read, 0 if none.
+ */
+int nrf24_credit_rx_read(nrf24_credit_rx_t *rx, uint8_t *buf, uint8_t *len, uint8_t *pipe)
+{
+    nrf24_t *nrf24 = rx->nrf24;
+    uint8_t frame[32];
+    uint8_t n;
+
+    while (nrf24_rxfifo_has_data(nrf24)) {
+        if (nrf24_rxfifo_read(nrf24, frame, &n, pipe) != 0) {
+            return 0;
+        }
+
+        /* every frame took the advert waiting in the ACK payload FIFO */
+        rx->rx_count++;
+        rx->is_loaded = 0;
+
+        if (n < 1 || frame[0] != FRAME_DATA) {
+            rx->stats.probes++;
+            continue;
+        }
+
+        if ((int16_t)(rx->rx_count - rx->limit) > 0) {
+            rx->stats.overruns++;
+        }
+        for (int i = 1; i < n; i++) {
+            buf[i - 1] = frame[i];
+        }
+        *len = n - 1;
+        rx->stats.frames++;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Advertise the free application buffer space with the next ACK.
+ *
+ * Rewrites the ACK payload only when the last one was used or the credit changed.
+ *
+ * @param free  Frames the application can still buffer.
+ * @param pipe  Pipe of the sender.
+ * @return 0 on success, or negative error code on failure.
+ */
+int nrf24_credit_rx_advertise(nrf24_credit_rx_t *rx, uint8_t free, uint8_t pipe)
+{
+    nrf24_t *nrf24 = rx->nrf24;
+    uint8_t advert[4];
+    int ret;
+
+    if (rx->is_loaded && free == rx->free) {
+        return 0;
+    }
+
+    advert[0] = FRAME_ADVERT;
+    advert[1] = (uint8_t)rx->rx_count;
+    advert[2] = (uint8_t)(rx->rx_count >> 8);
+    advert[3] = free;
+
+    /* only the latest advert is worth sending */
+    nrf24_txfifo_flush(nrf24);
+    ret = nrf24_txfifo_prx_write(nrf24, advert, sizeof(advert), pipe);
+    if (ret != 0) {
+        return ret;
+    }
+
+    rx->free = free;
+    rx->limit = rx->rx_count + free;
+    rx->is_loaded = 1;
+    rx->stats.adverts++;
+
+    return 0;
+}
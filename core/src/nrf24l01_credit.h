@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_CREDIT_H
+#define NRF24L01_CREDIT_H
+
+#include "nrf24l01.h"
+
+/* Credit based flow control
+ *
+ * The PRX advertises in its ACK payload how many frames it has taken out
+ * of the RX FIFO so far and how many more its application buffer can take:
+ * `[0xC5][rx_count LE16][free]`. The PTX counts the frames it sent and may
+ * only send while `free - (sent - rx_count)` is positive, so the receiver
+ * never has to drop a frame (or leave it in a full RX FIFO and make the
+ * sender burn retransmits) when its consumer falls behind.
+ *
+ * Data frames are `[0x00][data...]`; a stalled sender sends probe frames
+ * `[0x01]` every `probe_interval_ms` to fetch fresh credits. Probes are
+ * counted like data but never need a buffer.
+ *
+ * `free` must count only the application buffer; the receiver's RX path
+ * is expected to drain the RX FIFO into it promptly. The module owns the
+ * ACK payloads of the receiver.
+ */
+
+#define NRF24_CREDIT_MTU 31
+
+/**************/
+/*   Sender   */
+/**************/
+
+typedef struct {
+    uint32_t frames;
+    uint32_t probes;
+    uint32_t stalls;            // sends refused for lack of credit (once per stall)
+    uint32_t throttled_ms;      // total time spent stalled
+    uint32_t adverts;
+    uint32_t resyncs;           // receiver counter inconsistent (restarted)
+    uint32_t max_rt;
+} nrf24_credit_tx_stats_t;
+
+typedef struct {
+    nrf24_t *nrf24;
+
+    // parameters (defaults set by `nrf24_credit_tx_init()`)
+    uint32_t probe_interval_ms; // default 2
+
+    // state
+    uint16_t sent;
+    uint16_t rx_count;          // from the last advert
+    uint8_t free;               // from the last advert
+    uint8_t is_stalled;
+    uint32_t stall_since_ms;
+    uint32_t last_probe_ms;
+
+    nrf24_credit_tx_stats_t stats;
+} nrf24_credit_tx_t;
+
+int nrf24_credit_tx_init(nrf24_credit_tx_t *tx, nrf24_t *nrf24, uint8_t initial_credits);
+int nrf24_credit_tx_send(nrf24_credit_tx_t *tx, const uint8_t *data, uint8_t len, uint32_t now_ms);
+int nrf24_credit_tx_poll(nrf24_credit_tx_t *tx, uint32_t now_ms);
+int nrf24_credit_tx_credits(const nrf24_credit_tx_t *tx);
+
+/****************/
+/*   Receiver   */
+/****************/
+
+typedef struct {
+    uint32_t frames;
+    uint32_t probes;
+    uint32_t adverts;           // ACK payloads written
+    uint32_t overruns;          // frames beyond the advertised credit
+} nrf24_credit_rx_stats_t;
+
+typedef struct {
+    nrf24_t *nrf24;
+
+    // state
+    uint16_t rx_count;
+    uint16_t limit;             // rx_count + free of the last advert
+    uint8_t free;
+    uint8_t is_loaded;          // an advert is waiting in the ACK payload FIFO
+
+    nrf24_credit_rx_stats_t stats;
+} nrf24_credit_rx_t;
+
+int nrf24_credit_rx_init(nrf24_credit_rx_t *rx, nrf24_t *nrf24, uint8_t initial_credits);
+int nrf24_credit_rx_read(nrf24_credit_rx_t *rx, uint8_t *buf, uint8_t *len, uint8_t *pipe);
+int nrf24_credit_rx_advertise(nrf24_credit_rx_t *rx, uint8_t free, uint8_t pipe);
+
+#endif // NRF24L01_CREDIT_H
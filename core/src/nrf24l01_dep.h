@@ -12,6 +12,8 @@
 #define NRF24L01_DEP_H
 
 #include <stdint.h>
+#include "nrf24l01_user_cfg.h"
+#include "nrf24l01_trace.h"
 
 /* SPI specification */
 #ifdef NRF24L01_Si24R1_DEVICE
@@ -27,6 +29,9 @@ typedef struct nrf24_dep_ops nrf24_dep_ops_t;
 struct nrf24_dep {
     void *ctx;
     nrf24_dep_ops_t *ops;
+#ifdef NRF24L01_ENABLE_TRACE
+    nrf24_trace_t *trace; // optional transaction recorder (NULL: not recording)
+#endif
 };
 
 struct nrf24_dep_ops {
@@ -37,6 +42,11 @@ struct nrf24_dep_ops {
     int (*spi_send_then_recv)(void *ctx, const uint8_t *wbuf, uint8_t wlen, uint8_t *rbuf, uint8_t rlen);
     void (*set_ce_low)(void *ctx);
     void (*set_ce_high)(void *ctx);
+#ifdef NRF24L01_ENABLE_LOCK
+    /* Optional (NULL: no locking). Must be recursive, driver APIs nest. */
+    void (*lock)(void *ctx);
+    void (*unlock)(void *ctx);
+#endif
 };
 
 #endif // NRF24L01_DEP_H
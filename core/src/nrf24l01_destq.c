@@ -0,0 +1,215 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_destq.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+/// Compare the first `aw` bytes (the configured address width), the rest is don't care
+static int addr_equal(const uint8_t *a, const uint8_t *b, uint8_t aw)
+{
+    for (int i = 0; i < aw; i++) {
+        if (a[i] != b[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/// @return index of the oldest entry (for `addr` if given), -1 if none
+static int find_oldest(const nrf24_destq_t *q, const uint8_t *addr, uint8_t aw)
+{
+    int idx = -1;
+
+    for (int i = 0; i < q->num; i++) {
+        const nrf24_destq_entry_t *e = &q->entries[i];
+        if (!(e->flags & NRF24_DESTQ_FLAG_USED)) {
+            continue;
+        }
+        if (addr != 0 && !addr_equal(e->addr, addr, aw)) {
+            continue;
+        }
+        if (idx < 0 || (int32_t)(e->seq - q->entries[idx].seq) < 0) {
+            idx = i;
+        }
+    }
+
+    return idx;
+}
+
+/**
+ * @brief Initialize a per-destination queue.
+ *
+ * @param entries  Caller-provided storage.
+ * @param num      Number of entries.
+ * @return 0 on success.
+ */
+int nrf24_destq_init(nrf24_destq_t *q, nrf24_t *nrf24, nrf24_destq_entry_t *entries, uint16_t num)
+{
+    CHECK(q != 0 && nrf24 != 0 && entries != 0 && num > 0);
+
+    q->nrf24 = nrf24;
+    q->entries = entries;
+    q->num = num;
+    q->count = 0;
+    q->seq = 0;
+    q->has_cur = 0;
+    q->burst_max = 0;
+    q->burst = 0;
+    q->switches = 0;
+    q->fed = 0;
+
+    for (int i = 0; i < num; i++) {
+        entries[i].flags = 0;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Limit how many packets go to one destination before the oldest
+ *        waiting destination gets its turn (0: serve a destination until empty).
+ */
+void nrf24_destq_set_burst(nrf24_destq_t *q, uint8_t burst_max)
+{
+    q->burst_max = burst_max;
+}
+
+/**
+ * @brief Queue a packet (copied) for `addr`.
+ *
+ * @param addr    Destination address (LSB first, 5-byte buffer, the first `nrf24_addr_width()` bytes count).
+ * @param no_ack  send without requesting an ACK
+ * @return 0 on success, `NRF24_ERR_BUSY` if the queue is full.
+ */
+int nrf24_destq_push(nrf24_destq_t *q, const uint8_t *addr, const uint8_t *data, uint8_t len, uint8_t no_ack)
+{
+    CHECK(len > 0 && len <= 32);
+
+    if (q->count >= q->num) {
+        return NRF24_ERR_BUSY;
+    }
+
+    for (int i = 0; i < q->num; i++) {
+        nrf24_destq_entry_t *e = &q->entries[i];
+        if (e->flags & NRF24_DESTQ_FLAG_USED) {
+            continue;
+        }
+
+        e->seq = q->seq++;
+        e->len = len;
+        e->flags = NRF24_DESTQ_FLAG_USED | (no_ack ? NRF24_DESTQ_FLAG_NO_ACK : 0);
+        for (int k = 0; k < 5; k++) e->addr[k] = addr[k];
+        for (int k = 0; k < len; k++) e->data[k] = data[k];
+        q->count++;
+        return 0;
+    }
+
+    return NRF24_ERR_BUSY;
+}
+
+/**
+ * @brief Feed queued packets to the TX FIFO.
+ *
+ * Keeps serving the current destination while it has packets (up to the burst
+ * limit). Otherwise switches to the destination of the oldest queued packet,
+ * which only succeeds once the TX FIFO has drained.
+ *
+ * @return Number of packets written to the TX FIFO, or negative on error.
+ *
+ * @note Call after TX_DS (or periodically). TX failures (MAX_RT) are handled by
+ *       the caller as usual (e.g. `nrf24_txfifo_flush()`), the queue then continues.
+ */
+int nrf24_destq_pump(nrf24_destq_t *q)
+{
+    nrf24_t *nrf24 = q->nrf24;
+    uint8_t aw;
+    int idx;
+    int n = 0;
+    int ret;
+
+    if (q->count == 0) {
+        return 0;
+    }
+
+    aw = nrf24_addr_width(nrf24);
+
+    idx = -1;
+    if (q->has_cur && (q->burst_max == 0 || q->burst < q->burst_max)) {
+        idx = find_oldest(q, q->cur, aw);
+    }
+
+    if (idx < 0) {
+        idx = find_oldest(q, 0, aw);
+        if (!q->has_cur || !addr_equal(q->entries[idx].addr, q->cur, aw)) {
+            ret = nrf24_dest_set(nrf24, q->entries[idx].addr);
+            if (ret != 0) {
+                return ret == NRF24_ERR_BUSY ? 0 : ret;
+            }
+            for (int k = 0; k < 5; k++) q->cur[k] = q->entries[idx].addr[k];
+            q->has_cur = 1;
+            q->switches++;
+        }
+        q->burst = 0;
+    }
+
+    while (idx >= 0 && nrf24_txfifo_has_space(nrf24)) {
+        nrf24_destq_entry_t *e = &q->entries[idx];
+
+        if (e->flags & NRF24_DESTQ_FLAG_NO_ACK) {
+            ret = nrf24_txfifo_ptx_write_no_ack(nrf24, e->data, e->len);
+        } else {
+            ret = nrf24_txfifo_ptx_write(nrf24, e->data, e->len);
+        }
+        if (ret != 0) {
+            return ret;
+        }
+
+        e->flags = 0;
+        q->count--;
+        q->fed++;
+        q->burst++;
+        n++;
+
+        if (q->burst_max != 0 && q->burst >= q->burst_max) {
+            break;
+        }
+        idx = find_oldest(q, q->cur, aw);
+    }
+
+    return n;
+}
+
+/// @return Number of queued packets
+int nrf24_destq_pending(const nrf24_destq_t *q)
+{
+    return q->count;
+}
+
+/**
+ * @brief Drop all queued packets for `addr` (e.g. node is unreachable).
+ */
+void nrf24_destq_drop(nrf24_destq_t *q, const uint8_t *addr)
+{
+    uint8_t aw = nrf24_addr_width(q->nrf24);
+
+    for (int i = 0; i < q->num; i++) {
+        nrf24_destq_entry_t *e = &q->entries[i];
+        if ((e->flags & NRF24_DESTQ_FLAG_USED) && addr_equal(e->addr, addr, aw)) {
+            e->flags = 0;
+            q->count--;
+        }
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_DESTQ_H
+#define NRF24L01_DESTQ_H
+
+#include "nrf24l01.h"
+
+/* Per-destination TX queue (PTX)
+ *
+ * Packets are queued with their destination address and fed to the TX FIFO
+ * grouped by destination, so that consecutive packets to the same node share
+ * one address switch (see `nrf24_dest_set()`).
+ */
+
+#define NRF24_DESTQ_FLAG_USED   ((uint8_t)(1 << 0))
+#define NRF24_DESTQ_FLAG_NO_ACK ((uint8_t)(1 << 1))
+
+typedef struct {
+    uint32_t seq; // enqueue order
+    uint8_t addr[5];
+    uint8_t len;
+    uint8_t flags;
+    uint8_t data[32];
+} nrf24_destq_entry_t;
+
+typedef struct {
+    nrf24_t *nrf24;
+
+    nrf24_destq_entry_t *entries;
+    uint16_t num;
+    uint16_t count;
+    uint32_t seq;
+
+    // destination being served
+    uint8_t cur[5];
+    uint8_t has_cur;
+
+    // max packets fed to one destination while others are waiting (0: unlimited)
+    uint8_t burst_max;
+    uint8_t burst;
+
+    // statistics
+    uint32_t switches;
+    uint32_t fed;
+} nrf24_destq_t;
+
+int nrf24_destq_init(nrf24_destq_t *q, nrf24_t *nrf24, nrf24_destq_entry_t *entries, uint16_t num);
+void nrf24_destq_set_burst(nrf24_destq_t *q, uint8_t burst_max);
+int nrf24_destq_push(nrf24_destq_t *q, const uint8_t *addr, const uint8_t *data, uint8_t len, uint8_t no_ack);
+int nrf24_destq_pump(nrf24_destq_t *q);
+int nrf24_destq_pending(const nrf24_destq_t *q);
+void nrf24_destq_drop(nrf24_destq_t *q, const uint8_t *addr);
+
+#endif // NRF24L01_DESTQ_H
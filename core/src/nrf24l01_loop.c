@@ -0,0 +1,223 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_loop.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+static inline uint32_t loop_now(const nrf24_loop_t *loop)
+{
+    return loop->port->now_ms != 0 ? loop->port->now_ms(loop->port->ctx) : 0;
+}
+
+static inline void loop_wait(nrf24_loop_t *loop, uint32_t timeout_ms)
+{
+    if (loop->port->wait == 0) {
+        return; // POLL without `wait`: spin
+    }
+    loop->stats.blocks++;
+    loop->port->wait(loop->port->ctx, timeout_ms);
+}
+
+/**
+ * @brief Initialize an event loop (no I/O).
+ *
+ * @param cbs   Callbacks (any may be NULL).
+ * @param port  Platform hooks; `wait` is required except for POLL mode (without
+ *              it the loop spins, `poll_interval_ms` 0), `now_ms` for HYBRID rate tracking.
+ * @return 0 on success.
+ */
+int nrf24_loop_init(nrf24_loop_t *loop, nrf24_t *nrf24, nrf24_loop_mode_t mode, const nrf24_loop_cbs_t *cbs, const nrf24_loop_port_t *port)
+{
+    CHECK(loop != 0 && nrf24 != 0 && cbs != 0 && port != 0);
+    CHECK(mode <= NRF24_LOOP_HYBRID);
+    CHECK(port->wait != 0 || mode == NRF24_LOOP_POLL);
+
+    loop->nrf24 = nrf24;
+    loop->mode = mode;
+    loop->cbs = cbs;
+    loop->port = port;
+    loop->user_data = 0;
+
+    loop->poll_interval_ms = port->wait != 0 ? 1 : 0;
+    loop->irq_timeout_ms = 100;
+    loop->spin_limit = 64;
+    loop->rate_hi = 20;
+    loop->rate_window_ms = 10;
+
+    loop->spinning = mode == NRF24_LOOP_POLL;
+    loop->idle_polls = 0;
+    loop->win_start = 0;
+    loop->win_events = 0;
+    loop->stop = 0;
+
+    loop->stats = (nrf24_loop_stats_t){0};
+
+    return 0;
+}
+
+/**
+ * @brief Read status and dispatch events once.
+ *
+ * @return Number of events handled (packets received count one each).
+ */
+int nrf24_loop_poll(nrf24_loop_t *loop)
+{
+    nrf24_t *nrf24 = loop->nrf24;
+    const nrf24_loop_cbs_t *cbs = loop->cbs;
+    uint8_t buf[32];
+    uint8_t len;
+    uint8_t pipe;
+    int result;
+    int n = 0;
+
+    loop->stats.polls++;
+
+    result = nrf24_status_routine(nrf24, nrf24_read_and_clear_status(nrf24));
+    if (result == 0) {
+        return 0;
+    }
+
+    if (result & NRF24_STA_HAS_RXDATA) {
+        while (nrf24_rxfifo_has_data(nrf24)) {
+            if (nrf24_rxfifo_read(nrf24, buf, &len, &pipe) != 0) {
+                break;
+            }
+            n++;
+            if (cbs->on_rx != 0) {
+                cbs->on_rx(loop, buf, len, pipe);
+            }
+        }
+    }
+
+    if (result & NRF24_STA_TX_SENT) {
+        n++;
+        if (cbs->on_tx_sent != 0) {
+            cbs->on_tx_sent(loop);
+        }
+    }
+
+    if (result & NRF24_STA_TX_FAIL) {
+        n++;
+        if (cbs->on_tx_fail != 0) {
+            cbs->on_tx_fail(loop);
+        } else {
+            nrf24_txfifo_flush(nrf24);
+            nrf24_clear_txfail_flag(nrf24);
+        }
+    }
+
+    loop->stats.events += n;
+    return n;
+}
+
+static int run_hybrid(nrf24_loop_t *loop)
+{
+    int n;
+    uint32_t now;
+
+    // drain first, as in IRQ mode
+    n = nrf24_loop_poll(loop);
+
+    /* event rate over the window */
+    now = loop_now(loop);
+    loop->win_events += n;
+    if (now - loop->win_start >= loop->rate_window_ms) {
+        // rate_hi per rate_window_ms, scaled to the actual elapsed time (blocking may overshoot the window)
+        if (!loop->spinning && (uint64_t)loop->win_events * loop->rate_window_ms >= (uint64_t)loop->rate_hi * (now - loop->win_start)) {
+            loop->spinning = 1;
+            loop->idle_polls = 0;
+            loop->stats.mode_switches++;
+        }
+        loop->win_start = now;
+        loop->win_events = 0;
+    }
+
+    /* idle while spinning */
+    if (loop->spinning) {
+        if (n != 0) {
+            loop->idle_polls = 0;
+        } else if (++loop->idle_polls >= loop->spin_limit) {
+            loop->spinning = 0;
+            loop->stats.mode_switches++;
+        }
+    }
+
+    if (!loop->spinning && n == 0) {
+        if (loop->cbs->on_idle != 0) {
+            loop->cbs->on_idle(loop);
+        }
+        loop_wait(loop, loop->irq_timeout_ms);
+    }
+
+    return n;
+}
+
+/**
+ * @brief Run one iteration of the loop (may block, depending on the mode).
+ *
+ * @return Number of events handled.
+ */
+int nrf24_loop_run_once(nrf24_loop_t *loop)
+{
+    int n;
+
+    switch (loop->mode) {
+    case NRF24_LOOP_POLL:
+        n = nrf24_loop_poll(loop);
+        if (n == 0 && loop->poll_interval_ms != 0) {
+            if (loop->cbs->on_idle != 0) {
+                loop->cbs->on_idle(loop);
+            }
+            loop_wait(loop, loop->poll_interval_ms);
+        }
+        return n;
+
+    case NRF24_LOOP_IRQ:
+        // drain first: the IRQ line stays asserted until flags are cleared, an edge may be missed otherwise
+        n = nrf24_loop_poll(loop);
+        if (n == 0) {
+            if (loop->cbs->on_idle != 0) {
+                loop->cbs->on_idle(loop);
+            }
+            loop_wait(loop, loop->irq_timeout_ms);
+        }
+        return n;
+
+    default:
+        return run_hybrid(loop);
+    }
+}
+
+/**
+ * @brief Run until `nrf24_loop_stop()`.
+ */
+void nrf24_loop_run(nrf24_loop_t *loop)
+{
+    loop->stop = 0;
+    while (!loop->stop) {
+        nrf24_loop_run_once(loop);
+    }
+}
+
+/**
+ * @brief Make `nrf24_loop_run()` return (after the current iteration).
+ *
+ * @note When called from another thread, also signal the port so a blocked loop wakes up.
+ */
+void nrf24_loop_stop(nrf24_loop_t *loop)
+{
+    loop->stop = 1;
+}
@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_LOOP_H
+#define NRF24L01_LOOP_H
+
+#include "nrf24l01.h"
+
+/* Event loop runtime
+ *
+ * Replaces the hand-written `nrf24_status_routine(nrf24_read_and_clear_status())`
+ * loops: reads status, drains RX and dispatches callbacks.
+ *
+ * Modes:
+ * - POLL:   poll every `poll_interval_ms` (0: spin).
+ * - IRQ:    block on `port.wait` until the IRQ handler signals, then poll.
+ * - HYBRID: spin while events keep coming, block after `spin_limit` empty
+ *           polls, go back to spinning when the event rate reaches `rate_hi`
+ *           events per `rate_window_ms`.
+ */
+
+typedef enum {
+    NRF24_LOOP_POLL = 0,
+    NRF24_LOOP_IRQ = 1,
+    NRF24_LOOP_HYBRID = 2,
+} nrf24_loop_mode_t;
+
+typedef struct nrf24_loop nrf24_loop_t;
+
+typedef struct {
+    void (*on_tx_sent)(nrf24_loop_t *loop);
+    // MAX_RT is still set; if NULL the TX FIFO is flushed and the flag cleared
+    void (*on_tx_fail)(nrf24_loop_t *loop);
+    // `data` is only valid during the call
+    void (*on_rx)(nrf24_loop_t *loop, const uint8_t *data, uint8_t len, uint8_t pipe);
+    // optional, called before blocking (e.g. refill the TX FIFO)
+    void (*on_idle)(nrf24_loop_t *loop);
+} nrf24_loop_cbs_t;
+
+typedef struct {
+    // block until signaled (by the IRQ handler) or timeout (NRF24_LOOP_WAIT_FOREVER: none)
+    void (*wait)(void *ctx, uint32_t timeout_ms);
+    uint32_t (*now_ms)(void *ctx);
+    void *ctx;
+} nrf24_loop_port_t;
+
+#define NRF24_LOOP_WAIT_FOREVER 0xFFFFFFFFu
+
+typedef struct {
+    uint32_t polls;
+    uint32_t events;
+    uint32_t blocks;        // times the loop blocked in `wait`
+    uint32_t mode_switches; // hybrid spin <-> block transitions
+} nrf24_loop_stats_t;
+
+struct nrf24_loop {
+    nrf24_t *nrf24;
+    nrf24_loop_mode_t mode;
+    const nrf24_loop_cbs_t *cbs;
+    const nrf24_loop_port_t *port;
+    void *user_data;
+
+    // parameters (defaults set by `nrf24_loop_init()`)
+    uint32_t poll_interval_ms; // POLL, default 1 (0 without `port.wait`)
+    uint32_t irq_timeout_ms;   // IRQ/HYBRID: re-poll even without signal (lost edge safety)
+    uint16_t spin_limit;       // HYBRID
+    uint16_t rate_hi;          // HYBRID
+    uint32_t rate_window_ms;   // HYBRID
+
+    // state
+    uint8_t spinning;
+    uint16_t idle_polls;
+    uint32_t win_start;
+    uint32_t win_events;
+    volatile uint8_t stop;
+
+    nrf24_loop_stats_t stats;
+};
+
+int nrf24_loop_init(nrf24_loop_t *loop, nrf24_t *nrf24, nrf24_loop_mode_t mode, const nrf24_loop_cbs_t *cbs, const nrf24_loop_port_t *port);
+int nrf24_loop_poll(nrf24_loop_t *loop);
+int nrf24_loop_run_once(nrf24_loop_t *loop);
+void nrf24_loop_run(nrf24_loop_t *loop);
+void nrf24_loop_stop(nrf24_loop_t *loop);
+
+#endif // NRF24L01_LOOP_H
@@ -0,0 +1,277 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_lpl.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+/* Datasheet typical values (uA): PD, Standby-I, Standby-II, RX (2Mbps), TX (0dBm) */
+static const uint16_t default_ua[NRF24_PWR_STATE_NUM] = { 1, 26, 320, 13500, 11300 };
+
+/**
+ * @brief Initialize (no I/O).
+ *
+ * @param period_ms  Wake-up period (listener) / preamble length base (sender).
+ * @param window_ms  Listen window.
+ * @return 0 on success.
+ */
+int nrf24_lpl_init(nrf24_lpl_t *lpl, nrf24_t *nrf24, uint32_t period_ms, uint32_t window_ms)
+{
+    CHECK(lpl != 0 && nrf24 != 0 && window_ms > 0 && period_ms > window_ms);
+
+    lpl->nrf24 = nrf24;
+    lpl->on_rx = 0;
+    lpl->user_data = 0;
+
+    lpl->period_ms = period_ms;
+    lpl->min_period_ms = 0;
+    lpl->window_ms = window_ms;
+    for (int i = 0; i < NRF24_PWR_STATE_NUM; i++) {
+        lpl->ua[i] = default_ua[i];
+    }
+    lpl->supply_mv = 3000;
+
+    lpl->is_listening = 0;
+    lpl->is_awake = 0;
+    lpl->is_sending = 0;
+    lpl->had_traffic = 0;
+    lpl->tx_seq = 0;
+    lpl->last_seq = -1;
+    lpl->cur_period_ms = period_ms;
+
+    lpl->stats.wakeups = 0;
+    lpl->stats.rx = 0;
+    lpl->stats.dups = 0;
+    lpl->stats.sent = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Start duty-cycled listening; powers down until the first wake-up (now).
+ */
+int nrf24_lpl_listen(nrf24_lpl_t *lpl, uint32_t now_us)
+{
+    lpl->is_listening = 1;
+    lpl->is_awake = 0;
+    lpl->cur_period_ms = lpl->period_ms;
+    lpl->next_us = now_us;
+
+    return nrf24_pwr_request(lpl->nrf24, NRF24_PWR_DOWN, now_us);
+}
+
+/**
+ * @brief Send a frame preceded by a wake-up train long enough to span one listener period.
+ *
+ * @param len  <= NRF24_LPL_MTU
+ * @return 0 on success, `NRF24_ERR_BUSY` if a train is still running.
+ */
+int nrf24_lpl_send(nrf24_lpl_t *lpl, const uint8_t *data, uint8_t len, uint32_t now_us)
+{
+    nrf24_t *nrf24 = lpl->nrf24;
+    uint8_t frame[32];
+    int ret = 0;
+
+    CHECK(data != 0 && len > 0 && len <= NRF24_LPL_MTU);
+
+    if (lpl->is_sending) {
+        return NRF24_ERR_BUSY;
+    }
+
+    if (lpl->is_awake) {
+        lpl->is_awake = 0; // listen again on the next wake-up
+    }
+
+    frame[0] = ++lpl->tx_seq;
+    for (int i = 0; i < len; i++) {
+        frame[1 + i] = data[i];
+    }
+
+    /* load while CE is low, then repeat back to back */
+    ret += nrf24_pwr_request(nrf24, NRF24_PWR_STANDBY_I, now_us);
+    nrf24_txfifo_flush(nrf24);
+    ret += nrf24_txfifo_ptx_write_no_ack(nrf24, frame, len + 1);
+    ret += nrf24_txfifo_reuse(nrf24);
+    ret += nrf24_pwr_request(nrf24, NRF24_PWR_TX, now_us);
+
+    lpl->is_sending = 1;
+    lpl->tx_end_us = nrf24_pwr_ready_at(nrf24) + (lpl->period_ms + lpl->window_ms) * 1000;
+    lpl->stats.sent++;
+
+    return ret;
+}
+
+static void go_sleep(nrf24_lpl_t *lpl, uint32_t now_us)
+{
+    nrf24_pwr_request(lpl->nrf24, NRF24_PWR_DOWN, now_us);
+    lpl->is_awake = 0;
+
+    if (lpl->min_period_ms) {
+        if (lpl->had_traffic) {
+            lpl->cur_period_ms = lpl->min_period_ms;
+        }else {
+            lpl->cur_period_ms *= 2;
+            if (lpl->cur_period_ms > lpl->period_ms) {
+                lpl->cur_period_ms = lpl->period_ms;
+            }
+        }
+    }
+
+    lpl->next_us = lpl->wake_us + lpl->cur_period_ms * 1000;
+    if ((int32_t)(now_us - lpl->next_us) >= 0) {
+        lpl->next_us = now_us + lpl->cur_period_ms * 1000;
+    }
+}
+
+/// @return frames delivered
+static int drain(nrf24_lpl_t *lpl, uint32_t now_us)
+{
+    nrf24_t *nrf24 = lpl->nrf24;
+    uint8_t buf[32];
+    uint8_t len;
+    uint8_t pipe;
+    int n = 0;
+
+    nrf24_read_and_clear_status(nrf24);
+    while (nrf24_rxfifo_has_data(nrf24)) {
+        if (nrf24_rxfifo_read(nrf24, buf, &len, &pipe) != 0) {
+            break; // nothing was consumed, retrying here would spin
+        }
+        if (len < 2) {
+            continue;
+        }
+
+        if (buf[0] == lpl->last_seq) {
+            lpl->stats.dups++;
+            continue;
+        }
+
+        /* new frame, stay awake for more */
+        lpl->window_end_us = now_us + lpl->window_ms * 1000;
+        lpl->had_traffic = 1;
+        lpl->last_seq = buf[0];
+        lpl->stats.rx++;
+        n++;
+        if (lpl->on_rx) {
+            lpl->on_rx(lpl, buf + 1, len - 1, pipe);
+        }
+    }
+
+    return n;
+}
+
+/**
+ * @brief Run the duty cycle / preamble train; call often (at least every few ms while awake).
+ *
+ * @return Number of frames delivered.
+ */
+int nrf24_lpl_poll(nrf24_lpl_t *lpl, uint32_t now_us)
+{
+    nrf24_t *nrf24 = lpl->nrf24;
+    int n = 0;
+
+    if (lpl->is_sending) {
+        if ((int32_t)(now_us - lpl->tx_end_us) < 0) {
+            return 0;
+        }
+        nrf24_pwr_request(nrf24, NRF24_PWR_STANDBY_I, now_us);
+        nrf24_txfifo_flush(nrf24);
+        nrf24_pwr_request(nrf24, NRF24_PWR_DOWN, now_us);
+        lpl->is_sending = 0;
+    }
+
+    if (!lpl->is_listening) {
+        return 0;
+    }
+
+    if (!lpl->is_awake) {
+        if ((int32_t)(now_us - lpl->next_us) < 0) {
+            return 0;
+        }
+        nrf24_pwr_request(nrf24, NRF24_PWR_RX, now_us);
+        lpl->is_awake = 1;
+        lpl->had_traffic = 0;
+        lpl->wake_us = now_us;
+        lpl->window_end_us = nrf24_pwr_ready_at(nrf24) + lpl->window_ms * 1000;
+        lpl->stats.wakeups++;
+    }
+
+    if (!nrf24_pwr_is_ready(nrf24, now_us)) {
+        return 0;
+    }
+
+    n = drain(lpl, now_us);
+
+    if ((int32_t)(now_us - lpl->window_end_us) >= 0) {
+        go_sleep(lpl, now_us);
+    }
+
+    return n;
+}
+
+/// Stop listening / sending and power down.
+void nrf24_lpl_stop(nrf24_lpl_t *lpl, uint32_t now_us)
+{
+    lpl->is_listening = 0;
+    lpl->is_awake = 0;
+    if (lpl->is_sending) {
+        nrf24_pwr_request(lpl->nrf24, NRF24_PWR_STANDBY_I, now_us);
+        nrf24_txfifo_flush(lpl->nrf24);
+        lpl->is_sending = 0;
+    }
+    nrf24_pwr_request(lpl->nrf24, NRF24_PWR_DOWN, now_us);
+}
+
+/**
+ * @brief Energy used so far, from the power state residency and `ua`/`supply_mv`.
+ *
+ * @return Energy in uJ.
+ */
+uint32_t nrf24_lpl_energy_uj(const nrf24_lpl_t *lpl, uint32_t now_us)
+{
+    uint64_t e = 0; // uA * us
+
+    for (int i = 0; i < NRF24_PWR_STATE_NUM; i++) {
+        e += (uint64_t)lpl->ua[i] * nrf24_pwr_residency(lpl->nrf24, i, now_us);
+    }
+
+    return (uint32_t)(e * lpl->supply_mv / 1000 / 1000000);
+}
+
+/**
+ * @brief Estimated average listener current for the configuration (no traffic).
+ *
+ * Per period: start-up (Tpd2stby, ~Standby-I current), RX settling and window
+ * (RX current), powered down for the rest.
+ *
+ * @return Average current in uA.
+ */
+uint32_t nrf24_lpl_avg_current_ua(const nrf24_lpl_t *lpl)
+{
+    uint64_t period = (uint64_t)lpl->period_ms * 1000;
+    uint64_t rx = NRF24_TSTBY2A_US + (uint64_t)lpl->window_ms * 1000;
+    uint64_t on = NRF24_TPD2STBY_US + rx;
+    uint64_t q;
+
+    if (on >= period) {
+        return lpl->ua[NRF24_PWR_RX];
+    }
+
+    q = (uint64_t)lpl->ua[NRF24_PWR_STANDBY_I] * NRF24_TPD2STBY_US
+        + (uint64_t)lpl->ua[NRF24_PWR_RX] * rx
+        + (uint64_t)lpl->ua[NRF24_PWR_DOWN] * (period - on);
+
+    return (uint32_t)(q / period);
+}
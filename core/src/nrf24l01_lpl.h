@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_LPL_H
+#define NRF24L01_LPL_H
+
+#include "nrf24l01.h"
+
+/* Low-power listening (duty-cycled RX)
+ *
+ * Listener: powered down most of the time, wakes every `period_ms`, listens
+ * for `window_ms` (longer while traffic keeps coming) and powers down again.
+ * With `min_period_ms` set the period drops to it after traffic and doubles
+ * on every quiet wake-up, back to `period_ms`.
+ *
+ * Sender: repeats the frame (no-ack, REUSE_TX_PL with CE held high, so no
+ * SPI traffic per copy) for `period_ms + window_ms`, which spans one full
+ * listener period. Frames carry a 1-byte sequence number so the listener
+ * drops the extra copies.
+ *
+ * Uses the power state machine (`nrf24_pwr_request()`), all times are in us
+ * of the same free-running counter. Pipe 0 must have auto-ack disabled on
+ * the listener.
+ */
+
+#define NRF24_LPL_MTU 31
+
+typedef struct nrf24_lpl nrf24_lpl_t;
+
+typedef struct {
+    uint32_t wakeups;
+    uint32_t rx;       // frames delivered
+    uint32_t dups;     // extra preamble copies dropped
+    uint32_t sent;     // frames sent (preamble trains)
+} nrf24_lpl_stats_t;
+
+struct nrf24_lpl {
+    nrf24_t *nrf24;
+    // `data` is only valid during the call
+    void (*on_rx)(nrf24_lpl_t *lpl, const uint8_t *data, uint8_t len, uint8_t pipe);
+    void *user_data;
+
+    // parameters (defaults set by `nrf24_lpl_init()`)
+    uint32_t period_ms;     // (max) wake-up period
+    uint32_t min_period_ms; // adaptive: period after traffic, 0: off
+    uint32_t window_ms;     // listen window
+    uint16_t ua[NRF24_PWR_STATE_NUM]; // supply current per power state (uA)
+    uint16_t supply_mv;
+
+    // state
+    uint8_t is_listening;
+    uint8_t is_awake;
+    uint8_t is_sending;
+    uint8_t had_traffic;
+    uint8_t tx_seq;
+    int16_t last_seq;
+    uint32_t cur_period_ms;
+    uint32_t wake_us;
+    uint32_t next_us;
+    uint32_t window_end_us;
+    uint32_t tx_end_us;
+
+    nrf24_lpl_stats_t stats;
+};
+
+int nrf24_lpl_init(nrf24_lpl_t *lpl, nrf24_t *nrf24, uint32_t period_ms, uint32_t window_ms);
+int nrf24_lpl_listen(nrf24_lpl_t *lpl, uint32_t now_us);
+int nrf24_lpl_send(nrf24_lpl_t *lpl, const uint8_t *data, uint8_t len, uint32_t now_us);
+int nrf24_lpl_poll(nrf24_lpl_t *lpl, uint32_t now_us);
+void nrf24_lpl_stop(nrf24_lpl_t *lpl, uint32_t now_us);
+
+uint32_t nrf24_lpl_energy_uj(const nrf24_lpl_t *lpl, uint32_t now_us);
+uint32_t nrf24_lpl_avg_current_ua(const nrf24_lpl_t *lpl);
+
+#endif // NRF24L01_LPL_H
@@ -0,0 +1,288 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_pool.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+#include "./internal/atomic.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+#ifndef NRF24L01_PKT_TIMESTAMP
+#define NRF24L01_PKT_TIMESTAMP() 0
+#endif
+
+/* Atomics */
+#if defined(NRF24L01_CRITICAL_ENTER) && defined(NRF24L01_CRITICAL_EXIT)
+static int cas32(volatile uint32_t *p, uint32_t expect, uint32_t desired)
+{
+    int ok;
+    NRF24L01_CRITICAL_ENTER();
+    ok = *p == expect;
+    if (ok) {
+        *p = desired;
+    }
+    NRF24L01_CRITICAL_EXIT();
+    return ok;
+}
+
+static uint8_t add8(volatile uint8_t *p, int8_t v)
+{
+    uint8_t r;
+    NRF24L01_CRITICAL_ENTER();
+    r = *p += v;
+    NRF24L01_CRITICAL_EXIT();
+    return r;
+}
+
+static void add16(volatile uint16_t *p, int16_t v)
+{
+    NRF24L01_CRITICAL_ENTER();
+    *p += v;
+    NRF24L01_CRITICAL_EXIT();
+}
+#elif defined(__GNUC__)
+static int cas32(volatile uint32_t *p, uint32_t expect, uint32_t desired)
+{
+    return __atomic_compare_exchange_n(p, &expect, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+static uint8_t add8(volatile uint8_t *p, int8_t v)
+{
+    return __atomic_add_fetch(p, (uint8_t)v, __ATOMIC_ACQ_REL);
+}
+
+static void add16(volatile uint16_t *p, int16_t v)
+{
+    __atomic_add_fetch(p, (uint16_t)v, __ATOMIC_RELAXED);
+}
+#else
+#error "nrf24l01_pool needs GCC-style atomics or NRF24L01_CRITICAL_ENTER/EXIT"
+#endif
+
+#define HEAD_IDX(h) ((uint16_t)((h) & 0xFFFFu))
+#define HEAD_TAG(h) ((uint16_t)((h) >> 16))
+#define HEAD(idx, tag) ((uint32_t)(idx) | ((uint32_t)(tag) << 16))
+
+/********/
+/* Pool */
+/********/
+
+/**
+ * @brief Initialize a packet pool.
+ *
+ * @param pkts  Caller-provided slots.
+ * @param num   Number of slots (1 ~ 65534).
+ * @return 0 on success.
+ */
+int nrf24_pool_init(nrf24_pool_t *pool, nrf24_pkt_t *pkts, uint16_t num)
+{
+    CHECK(pool != 0 && pkts != 0 && num > 0 && num < NRF24_PKT_NONE);
+
+    pool->pkts = pkts;
+    pool->num = num;
+    pool->alloc_fail = 0;
+
+    for (uint16_t i = 0; i < num; i++) {
+        pkts[i].refcnt = 0;
+        pkts[i].next = i + 1;
+    }
+    pkts[num - 1].next = NRF24_PKT_NONE;
+
+    pool->avail = num;
+    pool->head = HEAD(0, 0);
+
+    return 0;
+}
+
+/**
+ * @brief Take a free slot (refcnt = 1).
+ *
+ * @return The slot, NULL if the pool is exhausted.
+ *
+ * @note Lock-free, ISR-safe.
+ */
+nrf24_pkt_t *nrf24_pkt_alloc(nrf24_pool_t *pool)
+{
+    uint32_t head;
+    uint32_t next;
+    nrf24_pkt_t *pkt;
+
+    do {
+        head = pool->head;
+        if (HEAD_IDX(head) == NRF24_PKT_NONE) {
+            pool->alloc_fail++;
+            return 0;
+        }
+        pkt = &pool->pkts[HEAD_IDX(head)];
+        next = HEAD(pkt->next, HEAD_TAG(head) + 1);
+    } while (!cas32(&pool->head, head, next));
+
+    add16(&pool->avail, -1);
+
+    pkt->refcnt = 1;
+    pkt->len = 0;
+    pkt->pipe = 0;
+    pkt->flags = 0;
+    pkt->ts = 0;
+
+    return pkt;
+}
+
+/**
+ * @brief Take another reference (e.g. the packet is in two queues).
+ */
+void nrf24_pkt_ref(nrf24_pkt_t *pkt)
+{
+    add8(&pkt->refcnt, 1);
+}
+
+/**
+ * @brief Drop a reference, the slot returns to the pool at zero.
+ *
+ * @note Lock-free, ISR-safe.
+ */
+void nrf24_pkt_unref(nrf24_pool_t *pool, nrf24_pkt_t *pkt)
+{
+    uint32_t head;
+    uint16_t idx = (uint16_t)(pkt - pool->pkts);
+
+    if (add8(&pkt->refcnt, -1) != 0) {
+        return;
+    }
+
+    do {
+        head = pool->head;
+        pkt->next = HEAD_IDX(head);
+    } while (!cas32(&pool->head, head, HEAD(idx, HEAD_TAG(head) + 1)));
+
+    add16(&pool->avail, 1);
+}
+
+/// @return Number of free slots
+uint16_t nrf24_pool_available(const nrf24_pool_t *pool)
+{
+    return pool->avail;
+}
+
+/**
+ * @brief Read one received packet straight into a new slot.
+ *
+ * @return The packet (caller owns one reference), NULL if there is no data or no free slot.
+ *
+ * @note On pool exhaustion the packet stays in the RX FIFO.
+ * @note ISR-safe only without `NRF24L01_ENABLE_LOCK`: the FIFO accessors then take the
+ *       instance mutex, so call it from a thread woken by the IRQ handler instead.
+ */
+nrf24_pkt_t *nrf24_pkt_rx(nrf24_t *nrf24, nrf24_pool_t *pool)
+{
+    nrf24_pkt_t *pkt;
+
+    if (!nrf24_rxfifo_has_data(nrf24)) {
+        return 0;
+    }
+
+    pkt = nrf24_pkt_alloc(pool);
+    if (pkt == 0) {
+        return 0;
+    }
+
+    if (nrf24_rxfifo_read(nrf24, pkt->data, &pkt->len, &pkt->pipe) != 0) {
+        nrf24_pkt_unref(pool, pkt);
+        return 0;
+    }
+#ifdef NRF24L01_ENABLE_TIMESTAMP
+    pkt->ts = nrf24_rx_timestamp(nrf24);
+#else
+    pkt->ts = NRF24L01_PKT_TIMESTAMP();
+#endif
+
+    return pkt;
+}
+
+/**
+ * @brief Write a packet slot to the TX FIFO (see `nrf24_txfifo_write()`).
+ *
+ * @note The slot is not released, the caller drops its reference when done.
+ */
+int nrf24_pkt_tx(nrf24_t *nrf24, const nrf24_pkt_t *pkt)
+{
+    return nrf24_txfifo_write(nrf24, pkt->data, pkt->len);
+}
+
+/*********/
+/* Queue */
+/*********/
+
+/**
+ * @param slots  Caller-provided storage.
+ * @param num    Capacity, power of 2.
+ */
+int nrf24_pktq_init(nrf24_pktq_t *q, nrf24_pkt_t **slots, uint16_t num)
+{
+    CHECK(q != 0 && slots != 0 && num > 0 && (num & (num - 1)) == 0);
+
+    q->slots = slots;
+    q->mask = num - 1;
+    q->wr = 0;
+    q->rd = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Enqueue (single producer, e.g. the ISR). Ownership of one reference moves with the pointer.
+ *
+ * @return 0 on success, `NRF24_ERR_BUSY` if full.
+ */
+int nrf24_pktq_push(nrf24_pktq_t *q, nrf24_pkt_t *pkt)
+{
+    uint16_t wr = q->wr;
+
+    if ((uint16_t)(wr - q->rd) > q->mask) {
+        return NRF24_ERR_BUSY;
+    }
+
+    q->slots[wr & q->mask] = pkt;
+    NRF24_BARRIER(); // slot visible before the index
+    q->wr = wr + 1;
+
+    return 0;
+}
+
+/**
+ * @brief Dequeue (single consumer, e.g. the application thread).
+ *
+ * @return The packet, NULL if empty.
+ */
+nrf24_pkt_t *nrf24_pktq_pop(nrf24_pktq_t *q)
+{
+    uint16_t rd = q->rd;
+    nrf24_pkt_t *pkt;
+
+    if (rd == q->wr) {
+        return 0;
+    }
+
+    NRF24_BARRIER(); // index read before the slot
+    pkt = q->slots[rd & q->mask];
+    NRF24_BARRIER();
+    q->rd = rd + 1;
+
+    return pkt;
+}
+
+uint16_t nrf24_pktq_count(const nrf24_pktq_t *q)
+{
+    return (uint16_t)(q->wr - q->rd);
+}
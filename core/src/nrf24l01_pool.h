@@ -0,0 +1,73 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_POOL_H
+#define NRF24L01_POOL_H
+
+#include "nrf24l01.h"
+
+/* Packet buffer pool
+ *
+ * Fixed 32-byte packet slots with metadata and a reference count. RX reads
+ * straight into a slot and hands the slot out; queues pass slot pointers.
+ *
+ * Allocation/free are lock-free (CAS on a tagged free-list head) and the
+ * packet queue is a single-producer/single-consumer ring, so an ISR can
+ * receive into the pool and hand packets to a thread without locks
+ * (not with `NRF24L01_ENABLE_LOCK`, see `nrf24_pkt_rx()`).
+ * Compilers without GCC-style `__atomic` builtins must define
+ * `NRF24L01_CRITICAL_ENTER()`/`NRF24L01_CRITICAL_EXIT()` instead.
+ */
+
+#define NRF24_PKT_NONE 0xFFFFu
+
+typedef struct {
+    uint8_t data[32];
+    uint8_t len;
+    uint8_t pipe;
+    volatile uint8_t refcnt;
+    uint8_t flags;   // free for application use
+    uint32_t ts;     // receive timestamp (`nrf24_rx_timestamp()`, per RX_DR event / `NRF24L01_PKT_TIMESTAMP()`, 0 if neither)
+    uint16_t next;   // free-list link (internal)
+} nrf24_pkt_t;
+
+typedef struct {
+    nrf24_pkt_t *pkts;
+    uint16_t num;
+    volatile uint32_t head;  // free-list head: index | tag << 16
+    volatile uint16_t avail;
+
+    // statistics
+    uint32_t alloc_fail;
+} nrf24_pool_t;
+
+/* SPSC packet queue (capacity must be a power of 2) */
+typedef struct {
+    nrf24_pkt_t **slots;
+    uint16_t mask;
+    volatile uint16_t wr;
+    volatile uint16_t rd;
+} nrf24_pktq_t;
+
+int nrf24_pool_init(nrf24_pool_t *pool, nrf24_pkt_t *pkts, uint16_t num);
+nrf24_pkt_t *nrf24_pkt_alloc(nrf24_pool_t *pool);
+void nrf24_pkt_ref(nrf24_pkt_t *pkt);
+void nrf24_pkt_unref(nrf24_pool_t *pool, nrf24_pkt_t *pkt);
+uint16_t nrf24_pool_available(const nrf24_pool_t *pool);
+
+nrf24_pkt_t *nrf24_pkt_rx(nrf24_t *nrf24, nrf24_pool_t *pool);
+int nrf24_pkt_tx(nrf24_t *nrf24, const nrf24_pkt_t *pkt);
+
+int nrf24_pktq_init(nrf24_pktq_t *q, nrf24_pkt_t **slots, uint16_t num);
+int nrf24_pktq_push(nrf24_pktq_t *q, nrf24_pkt_t *pkt);
+nrf24_pkt_t *nrf24_pktq_pop(nrf24_pktq_t *q);
+uint16_t nrf24_pktq_count(const nrf24_pktq_t *q);
+
+#endif // NRF24L01_POOL_H
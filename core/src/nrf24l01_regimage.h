@@ -0,0 +1,64 @@
+/*
+ * Register image (Gen by utils/regscfg: `./main --header`), do not edit by hand.
+ *
+ * Configuration:
+ *  - PTX mode
+ *  - Power down
+ *  - channel 2
+ *  - 2 bytes crc
+ *  - 5 bytes address width
+ *  - 9 times retransmit && 750us delay
+ */
+
+#ifndef NRF24L01_REGIMAGE_H
+#define NRF24L01_REGIMAGE_H
+
+#include "nrf24l01_reg.h"
+
+#define NRF24_REGIMAGE_CONFIG       0x0c
+#define NRF24_REGIMAGE_EN_AA        0x3f
+#define NRF24_REGIMAGE_EN_RXADDR    0x01
+#define NRF24_REGIMAGE_SETUP_AW     0x03
+#define NRF24_REGIMAGE_SETUP_RETR   0x29
+#define NRF24_REGIMAGE_RF_CH        0x02
+#define NRF24_REGIMAGE_RF_SETUP     0x0f
+#define NRF24_REGIMAGE_RX_ADDR_P2   0xc3
+#define NRF24_REGIMAGE_RX_ADDR_P3   0xc4
+#define NRF24_REGIMAGE_RX_ADDR_P4   0xc5
+#define NRF24_REGIMAGE_RX_ADDR_P5   0xc6
+#define NRF24_REGIMAGE_DYNPD        0x3f
+#define NRF24_REGIMAGE_FEATURE      0x07
+
+/* Multi-byte addresses (not part of the image, they belong to the user config) */
+#define NRF24_REGIMAGE_RX_ADDR_P0   0xe7, 0xe7, 0xe7, 0xe7, 0xe7 /* LSB first */
+#define NRF24_REGIMAGE_RX_ADDR_P1   0xc2, 0xc2, 0xc2, 0xc2, 0xc2 /* LSB first */
+#define NRF24_REGIMAGE_TX_ADDR      0xe7, 0xe7, 0xe7, 0xe7, 0xe7 /* LSB first */
+
+/* Runs of consecutive single-byte registers: {first_reg, num_regs, val...}, terminated by NRF24_REGIMAGE_END */
+#define NRF24_REGIMAGE_INITIALIZER { \
+    NRF24_REG_CONFIG, 7, \
+        NRF24_REGIMAGE_CONFIG, NRF24_REGIMAGE_EN_AA, NRF24_REGIMAGE_EN_RXADDR, NRF24_REGIMAGE_SETUP_AW, \
+        NRF24_REGIMAGE_SETUP_RETR, NRF24_REGIMAGE_RF_CH, NRF24_REGIMAGE_RF_SETUP, \
+    NRF24_REG_RX_ADDR_P2, 4, \
+        NRF24_REGIMAGE_RX_ADDR_P2, NRF24_REGIMAGE_RX_ADDR_P3, NRF24_REGIMAGE_RX_ADDR_P4, NRF24_REGIMAGE_RX_ADDR_P5, \
+    NRF24_REG_DYNPD, 2, \
+        NRF24_REGIMAGE_DYNPD, NRF24_REGIMAGE_FEATURE, \
+    NRF24_REGIMAGE_END }
+
+/* Field range checks (keep hand edits of the values above valid) */
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+    _Static_assert((NRF24_REGIMAGE_CONFIG & 0x80) == 0, "CONFIG: reserved bit must be 0");
+    _Static_assert((NRF24_REGIMAGE_CONFIG & REG_CONFIG_BITMASK_PWR_UP) == 0, "CONFIG: image must keep the device powered down");
+    _Static_assert(NRF24_REGIMAGE_EN_AA == 0 || (NRF24_REGIMAGE_CONFIG & REG_CONFIG_BITMASK_EN_CRC), "CONFIG: auto-ack requires CRC");
+    _Static_assert((NRF24_REGIMAGE_EN_AA & 0xC0) == 0, "EN_AA: pipe 0~5 only");
+    _Static_assert((NRF24_REGIMAGE_EN_RXADDR & 0xC0) == 0, "EN_RXADDR: pipe 0~5 only");
+    _Static_assert(NRF24_REGIMAGE_SETUP_AW >= 1 && NRF24_REGIMAGE_SETUP_AW <= 3, "SETUP_AW: address width must be 3~5 bytes");
+    _Static_assert((NRF24_REGIMAGE_RF_CH & 0x80) == 0 && NRF24_REGIMAGE_RF_CH <= 125, "RF_CH: channel must be 0~125");
+    _Static_assert((NRF24_REGIMAGE_RF_SETUP & 0x40) == 0, "RF_SETUP: reserved bit must be 0");
+    _Static_assert((NRF24_REGIMAGE_RF_SETUP & 0x28) != 0x28, "RF_SETUP: RF_DR_LOW and RF_DR_HIGH both set is reserved");
+    _Static_assert((NRF24_REGIMAGE_DYNPD & 0xC0) == 0, "DYNPD: pipe 0~5 only");
+    _Static_assert(NRF24_REGIMAGE_DYNPD == 0 || (NRF24_REGIMAGE_FEATURE & REG_FEATURE_BITMASK_EN_DPL), "DYNPD: requires FEATURE.EN_DPL");
+    _Static_assert((NRF24_REGIMAGE_FEATURE & 0xF8) == 0, "FEATURE: reserved bits must be 0");
+#endif
+
+#endif // NRF24L01_REGIMAGE_H
@@ -0,0 +1,282 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_rpc.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+/**************/
+/*   Client   */
+/**************/
+
+/**
+ * @brief Initialize an RPC client (no I/O); the radio must be set up as PTX
+ * with ACK payloads enabled and be on (CE high).
+ *
+ * @param calls      Storage for the calls in flight.
+ * @param num_calls  Max calls in flight (1..254).
+ * @return 0 on success.
+ */
+int nrf24_rpc_client_init(nrf24_rpc_client_t *cl, nrf24_t *nrf24, nrf24_rpc_call_t *calls, uint8_t num_calls)
+{
+    CHECK(cl != 0 && nrf24 != 0 && calls != 0);
+    CHECK(num_calls > 0 && num_calls < 255);
+
+    cl->nrf24 = nrf24;
+    cl->calls = calls;
+    cl->num_calls = num_calls;
+    cl->poll_interval_ms = 1;
+
+    cl->next_id = 1;
+    cl->outstanding = 0;
+    cl->last_poll_ms = 0;
+
+    for (int i = 0; i < num_calls; i++) {
+        calls[i].id = 0;
+    }
+
+    cl->stats.calls = 0;
+    cl->stats.responses = 0;
+    cl->stats.timeouts = 0;
+    cl->stats.stale = 0;
+    cl->stats.polls = 0;
+    cl->stats.max_rt = 0;
+
+    return 0;
+}
+
+static nrf24_rpc_call_t *find_call(nrf24_rpc_client_t *cl, uint8_t id)
+{
+    for (int i = 0; i < cl->num_calls; i++) {
+        if (cl->calls[i].id == id) {
+            return &cl->calls[i];
+        }
+    }
+
+    return 0;
+}
+
+/// Next id (1..255) not used by a call in flight
+static uint8_t alloc_id(nrf24_rpc_client_t *cl)
+{
+    uint8_t id = cl->next_id;
+
+    while (find_call(cl, id) != 0) {
+        id = id == 255 ? 1 : id + 1;
+    }
+    cl->next_id = id == 255 ? 1 : id + 1;
+
+    return id;
+}
+
+/**
+ * @brief Issue a request; `done` is called from `nrf24_rpc_client_poll()`
+ * with the response or NRF24_RPC_TIMEOUT.
+ *
+ * @param len         Argument length (0..NRF24_RPC_MAX_ARGS).
+ * @param timeout_ms  Time to wait for the response.
+ * @return Request id (> 0) on success, NRF24_ERR_BUSY if all call slots are
+ *         in use or the TX FIFO is full.
+ */
+int nrf24_rpc_call(nrf24_rpc_client_t *cl, uint8_t method, const uint8_t *args, uint8_t len, uint32_t timeout_ms, nrf24_rpc_done_t done, void *user, uint32_t now_ms)
+{
+    nrf24_rpc_call_t *call;
+    uint8_t frame[32];
+    int ret;
+
+    CHECK(len <= NRF24_RPC_MAX_ARGS && (len == 0 || args != 0) && done != 0);
+
+    call = find_call(cl, 0);
+    if (call == 0 || !nrf24_txfifo_has_space(cl->nrf24)) {
+        return NRF24_ERR_BUSY;
+    }
+
+    frame[0] = alloc_id(cl);
+    frame[1] = method;
+    for (int i = 0; i < len; i++) {
+        frame[2 + i] = args[i];
+    }
+
+    ret = nrf24_txfifo_ptx_write(cl->nrf24, frame, len + 2);
+    if (ret != 0) {
+        return ret;
+    }
+
+    call->id = frame[0];
+    call->deadline_ms = now_ms + timeout_ms;
+    call->done = done;
+    call->user = user;
+    cl->outstanding++;
+    cl->stats.calls++;
+
+    return call->id;
+}
+
+static void complete(nrf24_rpc_client_t *cl, nrf24_rpc_call_t *call, uint8_t status, const uint8_t *data, uint8_t len)
+{
+    nrf24_rpc_done_t done = call->done;
+    void *user = call->user;
+
+    /* free the slot first, `done` may issue the next call */
+    call->id = 0;
+    cl->outstanding--;
+    done(cl, user, status, data, len);
+}
+
+/**
+ * @brief Collect responses, expire calls and send poll frames; call often.
+ *
+ * @param now_ms  Current time.
+ * @return Number of calls completed (responses and timeouts).
+ */
+int nrf24_rpc_client_poll(nrf24_rpc_client_t *cl, uint32_t now_ms)
+{
+    nrf24_t *nrf24 = cl->nrf24;
+    int n = 0;
+    int result;
+
+    result = nrf24_status_routine(nrf24, nrf24_read_and_clear_status(nrf24));
+
+    if (result & NRF24_STA_TX_FAIL) {
+        /* the requests in the FIFO may never arrive, their calls time out */
+        cl->stats.max_rt++;
+        nrf24_txfifo_flush(nrf24);
+        nrf24_clear_txfail_flag(nrf24);
+    }
+
+    /* ACK payloads (TX_FAIL hides RX_DR, check the FIFO too) */
+    if (result != NRF24_STA_NONE) {
+        uint8_t buf[32];
+        uint8_t len;
+        uint8_t pipe;
+
+        while (nrf24_rxfifo_has_data(nrf24)) {
+            nrf24_rpc_call_t *call;
+
+            if (nrf24_rxfifo_read(nrf24, buf, &len, &pipe) != 0) {
+                break;
+            }
+            call = len >= 2 && buf[0] != 0 ? find_call(cl, buf[0]) : 0;
+            if (call == 0) {
+                cl->stats.stale++;
+                continue;
+            }
+            cl->stats.responses++;
+            complete(cl, call, buf[1], buf + 2, len - 2);
+            n++;
+        }
+    }
+
+    for (int i = 0; i < cl->num_calls; i++) {
+        nrf24_rpc_call_t *call = &cl->calls[i];
+        if (call->id != 0 && (int32_t)(now_ms - call->deadline_ms) >= 0) {
+            cl->stats.timeouts++;
+            complete(cl, call, NRF24_RPC_TIMEOUT, 0, 0);
+            n++;
+        }
+    }
+
+    /* keep the responses coming */
+    if (cl->outstanding > 0 && now_ms - cl->last_poll_ms >= cl->poll_interval_ms
+        && nrf24_txfifo_is_empty(nrf24)) {
+        uint8_t poll = 0;
+        if (nrf24_txfifo_ptx_write(nrf24, &poll, 1) == 0) {
+            cl->last_poll_ms = now_ms;
+            cl->stats.polls++;
+        }
+    }
+
+    return n;
+}
+
+/// Number of calls waiting for their response.
+uint8_t nrf24_rpc_outstanding(const nrf24_rpc_client_t *cl)
+{
+    return cl->outstanding;
+}
+
+/**************/
+/*   Server   */
+/**************/
+
+/**
+ * @brief Initialize an RPC server (no I/O); the radio must be set up as PRX
+ * with ACK payloads enabled.
+ *
+ * @return 0 on success.
+ */
+int nrf24_rpc_server_init(nrf24_rpc_server_t *srv, nrf24_t *nrf24, nrf24_rpc_handler_t handler, void *user_data)
+{
+    CHECK(srv != 0 && nrf24 != 0 && handler != 0);
+
+    srv->nrf24 = nrf24;
+    srv->handler = handler;
+    srv->user_data = user_data;
+
+    srv->stats.requests = 0;
+    srv->stats.polls = 0;
+    srv->stats.malformed = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Serve received requests while there is room for their responses; call often.
+ *
+ * @return Number of requests served.
+ */
+int nrf24_rpc_server_poll(nrf24_rpc_server_t *srv)
+{
+    nrf24_t *nrf24 = srv->nrf24;
+    uint8_t buf[32];
+    uint8_t resp[32];
+    uint8_t len;
+    uint8_t pipe;
+    int n = 0;
+
+    nrf24_read_and_clear_status(nrf24);
+
+    while (nrf24_rxfifo_has_data(nrf24)) {
+        uint8_t resp_len = 0;
+
+        /* peek is not possible, so only take a request we can answer */
+        if (!nrf24_txfifo_has_space(nrf24)) {
+            break;
+        }
+        if (nrf24_rxfifo_read(nrf24, buf, &len, &pipe) != 0) {
+            break;
+        }
+
+        if (len == 1 && buf[0] == 0) {
+            srv->stats.polls++;
+            continue;
+        }
+        if (len < 2 || buf[0] == 0) {
+            srv->stats.malformed++;
+            continue;
+        }
+
+        resp[0] = buf[0];
+        resp[1] = srv->handler(srv, buf[1], buf + 2, len - 2, resp + 2, &resp_len);
+        if (resp_len > NRF24_RPC_MAX_DATA) {
+            resp_len = NRF24_RPC_MAX_DATA;
+        }
+        nrf24_txfifo_prx_write(nrf24, resp, resp_len + 2, pipe);
+        srv->stats.requests++;
+        n++;
+    }
+
+    return n;
+}
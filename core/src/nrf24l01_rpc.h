@@ -0,0 +1,107 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_RPC_H
+#define NRF24L01_RPC_H
+
+#include "nrf24l01.h"
+
+/* RPC over ACK payloads
+ *
+ * The client (PTX) sends requests `[id][method][args...]`; the server (PRX)
+ * answers each with an ACK payload `[id][status][data...]` written with
+ * `nrf24_txfifo_prx_write()`. An ACK payload can only go out with the
+ * packet after the one that caused it, so a response rides on the ACK of
+ * the next request; when the client has nothing more to send it keeps
+ * the responses coming with one byte poll frames `[0]`. No role switch
+ * is ever needed and up to `num_calls` requests are in flight at once.
+ *
+ * Responses are matched by id; a call without response after its timeout
+ * completes with NRF24_RPC_TIMEOUT and a late response to it is dropped.
+ *
+ * The server drains requests only while it has room for the responses
+ * (3 ACK payloads); beyond that the RX FIFO fills and the client sees
+ * retransmissions, which is the flow control.
+ */
+
+#define NRF24_RPC_MAX_ARGS 30   // request: id, method
+#define NRF24_RPC_MAX_DATA 30   // response: id, status
+
+#define NRF24_RPC_OK       0
+#define NRF24_RPC_TIMEOUT  0xFF // client side, never sent by a server
+
+typedef struct nrf24_rpc_client nrf24_rpc_client_t;
+
+// `data` is only valid during the call; status is the server's (or NRF24_RPC_TIMEOUT)
+typedef void (*nrf24_rpc_done_t)(nrf24_rpc_client_t *cl, void *user, uint8_t status, const uint8_t *data, uint8_t len);
+
+typedef struct {
+    uint8_t id;                 // 0: free
+    uint32_t deadline_ms;
+    nrf24_rpc_done_t done;
+    void *user;
+} nrf24_rpc_call_t;
+
+typedef struct {
+    uint32_t calls;
+    uint32_t responses;
+    uint32_t timeouts;
+    uint32_t stale;             // responses to unknown or timed out ids
+    uint32_t polls;             // poll frames sent
+    uint32_t max_rt;
+} nrf24_rpc_client_stats_t;
+
+struct nrf24_rpc_client {
+    nrf24_t *nrf24;
+    nrf24_rpc_call_t *calls;
+    uint8_t num_calls;
+
+    // parameters (defaults set by `nrf24_rpc_client_init()`)
+    uint32_t poll_interval_ms;  // min time between poll frames, default 1
+
+    // state
+    uint8_t next_id;
+    uint8_t outstanding;
+    uint32_t last_poll_ms;
+
+    nrf24_rpc_client_stats_t stats;
+};
+
+typedef struct nrf24_rpc_server nrf24_rpc_server_t;
+
+/**
+ * Serve one request; write at most NRF24_RPC_MAX_DATA bytes to `resp`.
+ * @return The status byte sent back (NRF24_RPC_OK or an application code < 0xFF).
+ */
+typedef uint8_t (*nrf24_rpc_handler_t)(nrf24_rpc_server_t *srv, uint8_t method, const uint8_t *args, uint8_t len, uint8_t *resp, uint8_t *resp_len);
+
+typedef struct {
+    uint32_t requests;
+    uint32_t polls;
+    uint32_t malformed;
+} nrf24_rpc_server_stats_t;
+
+struct nrf24_rpc_server {
+    nrf24_t *nrf24;
+    nrf24_rpc_handler_t handler;
+    void *user_data;
+
+    nrf24_rpc_server_stats_t stats;
+};
+
+int nrf24_rpc_client_init(nrf24_rpc_client_t *cl, nrf24_t *nrf24, nrf24_rpc_call_t *calls, uint8_t num_calls);
+int nrf24_rpc_call(nrf24_rpc_client_t *cl, uint8_t method, const uint8_t *args, uint8_t len, uint32_t timeout_ms, nrf24_rpc_done_t done, void *user, uint32_t now_ms);
+int nrf24_rpc_client_poll(nrf24_rpc_client_t *cl, uint32_t now_ms);
+uint8_t nrf24_rpc_outstanding(const nrf24_rpc_client_t *cl);
+
+int nrf24_rpc_server_init(nrf24_rpc_server_t *srv, nrf24_t *nrf24, nrf24_rpc_handler_t handler, void *user_data);
+int nrf24_rpc_server_poll(nrf24_rpc_server_t *srv);
+
+#endif // NRF24L01_RPC_H
@@ -0,0 +1,260 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_stream.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+#include "./internal/atomic.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+/**
+ * @brief Initialize a frame ring (single producer, single consumer).
+ *
+ * @param frames  Frame storage, `num` entries.
+ * @param lens    Length storage, `num` entries.
+ */
+int nrf24_stream_ring_init(nrf24_stream_ring_t *ring, uint8_t (*frames)[32], uint8_t *lens, uint16_t num)
+{
+    CHECK(ring != 0 && frames != 0 && lens != 0 && num > 1);
+
+    ring->frames = frames;
+    ring->lens = lens;
+    ring->num = num;
+    ring->head = 0;
+    ring->tail = 0;
+
+    return 0;
+}
+
+/**
+ * @return 0 on success, `NRF24_ERR_BUSY` if the ring is full.
+ */
+int nrf24_stream_ring_put(nrf24_stream_ring_t *ring, const uint8_t *data, uint8_t len)
+{
+    uint16_t next;
+
+    CHECK(data != 0 && len > 0 && len <= 32);
+
+    next = (ring->tail + 1) % ring->num;
+    if (next == ring->head) {
+        return NRF24_ERR_BUSY;
+    }
+
+    for (int i = 0; i < len; i++) {
+        ring->frames[ring->tail][i] = data[i];
+    }
+    ring->lens[ring->tail] = len;
+    NRF24_BARRIER();
+    ring->tail = next;
+
+    return 0;
+}
+
+/// Producer callback reading from a `nrf24_stream_ring_t` (ctx)
+int nrf24_stream_ring_produce(void *ctx, uint8_t *buf)
+{
+    nrf24_stream_ring_t *ring = ctx;
+    uint16_t head = ring->head;
+    int len;
+
+    if (head == ring->tail) {
+        return 0;
+    }
+
+    NRF24_BARRIER();
+    len = ring->lens[head];
+    for (int i = 0; i < len; i++) {
+        buf[i] = ring->frames[head][i];
+    }
+    NRF24_BARRIER(); // slot copied before it is handed back
+    ring->head = (head + 1) % ring->num;
+
+    return len;
+}
+
+/**
+ * @brief Initialize a stream (no I/O); the radio must be set up as PTX.
+ *
+ * @param produce  Payload source, see `nrf24_stream_produce_t`.
+ */
+int nrf24_stream_init(nrf24_stream_t *s, nrf24_t *nrf24, nrf24_stream_produce_t produce, void *ctx)
+{
+    CHECK(s != 0 && nrf24 != 0 && produce != 0);
+
+    s->nrf24 = nrf24;
+    s->produce = produce;
+    s->ctx = ctx;
+    s->max_rt_retries = 0;
+    s->max_rt_streak = 0;
+    s->inflight = 0;
+    s->inflight_head = 0;
+    s->is_running = 0;
+    s->pending_len = 0;
+
+    s->stats.packets = 0;
+    s->stats.bytes = 0;
+    s->stats.max_rt = 0;
+    s->stats.lost = 0;
+    s->stats.underruns = 0;
+    s->stats.start_ms = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Start streaming: raise CE and prefill the TX FIFO.
+ *
+ * @param now_ms  Current time, the origin of `nrf24_stream_throughput()`.
+ * @return Number of payloads written.
+ */
+int nrf24_stream_start(nrf24_stream_t *s, uint32_t now_ms)
+{
+    s->stats.start_ms = now_ms;
+    s->is_running = 1;
+    nrf24_radio_on(s->nrf24);
+
+    return nrf24_stream_poll(s);
+}
+
+/// Account the `n` oldest payloads as acknowledged
+static void done(nrf24_stream_t *s, int n)
+{
+    while (n-- > 0 && s->inflight > 0) {
+        s->stats.packets++;
+        s->stats.bytes += s->inflight_len[s->inflight_head];
+        s->inflight_head = (s->inflight_head + 1) & 3;
+        s->inflight--;
+    }
+}
+
+/// Write payloads until the FIFO is full or the producer is dry. @return payloads written
+static int refill(nrf24_stream_t *s, int *is_full)
+{
+    nrf24_t *nrf24 = s->nrf24;
+    int n = 0;
+
+    *is_full = 0;
+    while (s->inflight < 4) {
+        if (!nrf24_txfifo_has_space(nrf24)) {
+            *is_full = 1;
+            break;
+        }
+        if (s->pending_len == 0) {
+            int len = s->produce(s->ctx, s->pending);
+            if (len <= 0) {
+                break;
+            }
+            s->pending_len = len > 32 ? 32 : len;
+        }
+        if (nrf24_txfifo_ptx_write(nrf24, s->pending, s->pending_len) != 0) {
+            break;
+        }
+        s->inflight_len[(s->inflight_head + s->inflight) & 3] = s->pending_len;
+        s->inflight++;
+        s->pending_len = 0;
+        n++;
+    }
+
+    return n;
+}
+
+/**
+ * @brief Handle TX_DS / MAX_RT and top the TX FIFO up; call on every IRQ (or often).
+ *
+ * The number of acknowledged payloads is derived from how many writes it
+ * takes to fill the FIFO again, so merged TX_DS events are counted right.
+ *
+ * On MAX_RT the payload is re-armed `max_rt_retries` times, then the FIFO is
+ * flushed (its payloads count as lost) and streaming continues.
+ *
+ * @return Number of payloads written.
+ */
+int nrf24_stream_poll(nrf24_stream_t *s)
+{
+    nrf24_t *nrf24 = s->nrf24;
+    nrf24_fifosta_t fifosta;
+    uint8_t sta;
+    int result;
+    int is_full;
+    int n;
+
+    if (!s->is_running) {
+        return 0;
+    }
+
+    sta = nrf24_read_and_clear_status(nrf24);
+    result = nrf24_status_routine(nrf24, sta);
+
+    if (result & NRF24_STA_TX_FAIL) {
+        s->stats.max_rt++;
+        if (s->max_rt_streak++ >= s->max_rt_retries) {
+            /* what left the FIFO before the failing payload was acknowledged */
+            fifosta = nrf24_read_fifosta(nrf24);
+            if (!fifosta.tx_full) {
+                done(s, s->inflight > 2 ? s->inflight - 2 : ((sta & REG_STATUS_BITMASK_TX_DS) ? 1 : 0));
+            }
+            nrf24_txfifo_flush(nrf24);
+            s->stats.lost += s->inflight;
+            s->inflight = 0;
+            s->max_rt_streak = 0;
+        }
+        nrf24_clear_txfail_flag(nrf24);
+    } else if (result & NRF24_STA_TX_SENT) {
+        s->max_rt_streak = 0;
+    }
+
+    fifosta = nrf24_read_fifosta(nrf24);
+    if (fifosta.tx_empty) {
+        if (s->inflight > 0) {
+            s->stats.underruns++;
+        }
+        done(s, s->inflight);
+        return refill(s, &is_full);
+    }
+    if (fifosta.tx_full) {
+        return 0;
+    }
+
+    /* 1 or 2 left in the FIFO */
+    if (s->inflight > 2) {
+        done(s, s->inflight - 2);
+    }
+    n = refill(s, &is_full);
+    if (is_full) {
+        done(s, s->inflight - 3);
+    } else if (n == 0 && (result & NRF24_STA_TX_SENT)) {
+        done(s, 1);
+    }
+
+    return n;
+}
+
+/// Stop streaming: drop CE; what is left in the TX FIFO stays there.
+void nrf24_stream_stop(nrf24_stream_t *s)
+{
+    s->is_running = 0;
+    nrf24_radio_off(s->nrf24);
+}
+
+/// @return Acknowledged payload bytes per second since `nrf24_stream_start()`
+uint32_t nrf24_stream_throughput(const nrf24_stream_t *s, uint32_t now_ms)
+{
+    uint32_t elapsed = now_ms - s->stats.start_ms;
+
+    if (elapsed == 0) {
+        return 0;
+    }
+
+    return (uint32_t)((uint64_t)s->stats.bytes * 1000 / elapsed);
+}
@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_STREAM_H
+#define NRF24L01_STREAM_H
+
+#include "nrf24l01.h"
+
+/* Streaming TX engine (PTX)
+ *
+ * Keeps CE high for the whole stream and tops the TX FIFO up on every TX_DS
+ * (call `nrf24_stream_poll()` from the IRQ handler / loop), so the chip goes
+ * from one packet straight to the next without re-settling the PLL. When
+ * the producer runs dry the chip idles in Standby-II and resumes on the next
+ * write.
+ *
+ * Payloads come from a producer callback; `nrf24_stream_ring_produce` with a
+ * `nrf24_stream_ring_t` as ctx is a ready-made single-producer ring buffer.
+ */
+
+/**
+ * @brief Fill the next payload.
+ *
+ * @param buf  32-byte buffer.
+ * @return Payload length (1-32), 0 if nothing is ready now.
+ */
+typedef int (*nrf24_stream_produce_t)(void *ctx, uint8_t *buf);
+
+typedef struct {
+    uint8_t (*frames)[32];
+    uint8_t *lens;
+    uint16_t num;
+    volatile uint16_t head; // written by the consumer
+    volatile uint16_t tail; // written by the producer
+} nrf24_stream_ring_t;
+
+typedef struct {
+    uint32_t packets;   // acknowledged
+    uint32_t bytes;     // acknowledged payload bytes
+    uint32_t max_rt;    // MAX_RT events
+    uint32_t lost;      // packets flushed after MAX_RT (may include some acknowledged just before, if polled late)
+    uint32_t underruns; // FIFO found empty while streaming
+    uint32_t start_ms;
+} nrf24_stream_stats_t;
+
+typedef struct {
+    nrf24_t *nrf24;
+    nrf24_stream_produce_t produce;
+    void *ctx;
+
+    uint8_t max_rt_retries; // re-arm count before flushing, default 0
+    uint8_t max_rt_streak;
+    uint8_t inflight;       // payloads in the TX FIFO (estimate until it is seen full or empty)
+    uint8_t inflight_head;
+    uint8_t inflight_len[4];
+    uint8_t is_running;
+
+    /* a payload taken from the producer but not yet written */
+    uint8_t pending[32];
+    uint8_t pending_len;
+
+    nrf24_stream_stats_t stats;
+} nrf24_stream_t;
+
+int nrf24_stream_ring_init(nrf24_stream_ring_t *ring, uint8_t (*frames)[32], uint8_t *lens, uint16_t num);
+int nrf24_stream_ring_put(nrf24_stream_ring_t *ring, const uint8_t *data, uint8_t len);
+int nrf24_stream_ring_produce(void *ctx, uint8_t *buf);
+
+int nrf24_stream_init(nrf24_stream_t *s, nrf24_t *nrf24, nrf24_stream_produce_t produce, void *ctx);
+int nrf24_stream_start(nrf24_stream_t *s, uint32_t now_ms);
+int nrf24_stream_poll(nrf24_stream_t *s);
+void nrf24_stream_stop(nrf24_stream_t *s);
+uint32_t nrf24_stream_throughput(const nrf24_stream_t *s, uint32_t now_ms);
+
+#endif // NRF24L01_STREAM_H
@@ -0,0 +1,404 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_stripe.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+/* Retransmit average: EWMA with 1/8 gain, x16 fixed-point */
+#define ARC_SCALE 16
+#define ARC_FAIL  16 // a MAX_RT counts as 16 retransmits
+
+/**
+ * @brief Bring up K radios with the same role, one channel each.
+ *
+ * @param ucfg      Base user config, channel is overridden.
+ * @param channels  `num` distinct channels (the peer uses the same list, in the same order).
+ * @return 0 on success.
+ */
+int nrf24_stripe_setup(nrf24_t **radios, uint8_t num, nrf24_role_enum_t role, const nrf24_user_cfg_t *ucfg, const uint8_t *channels)
+{
+    int ret = 0;
+    nrf24_user_cfg_t cfg = *ucfg;
+
+    for (int i = 0; i < num; i++) {
+        CHECK(channels[i] <= 125);
+        cfg.rf_channel = channels[i];
+        ret += nrf24_setup_image(radios[i], role, &cfg, nrf24_default_regimage);
+    }
+
+    return ret;
+}
+
+/**********/
+/* Sender */
+/**********/
+
+static void rebalance(nrf24_stripe_txm_t *m)
+{
+    // cost per frame is (1 + arc) transmissions
+    m->weight = (uint16_t)(256u * ARC_SCALE / (ARC_SCALE + m->arc_avg));
+}
+
+/**
+ * @brief Initialize the sending side (no I/O).
+ *
+ * @param members  Storage, one per radio.
+ * @param radios   Set-up PTX instances (see `nrf24_stripe_setup()`).
+ * @param num      Number of radios (1 ~ NRF24_STRIPE_RADIOS_MAX).
+ * @param q        Send queue storage.
+ * @return 0 on success.
+ */
+int nrf24_stripe_tx_init(nrf24_stripe_tx_t *tx, nrf24_stripe_txm_t *members, nrf24_t **radios, uint8_t num,
+                         nrf24_stripe_slot_t *q, uint8_t q_num)
+{
+    CHECK(tx != 0 && members != 0 && radios != 0 && num > 0 && num <= NRF24_STRIPE_RADIOS_MAX);
+    CHECK(q != 0 && q_num > 0);
+
+    tx->members = members;
+    tx->num = num;
+    tx->q = q;
+    tx->q_num = q_num;
+    tx->q_head = 0;
+    tx->q_count = 0;
+    tx->seq = 0;
+    tx->max_rt_limit = 8;
+
+    for (int i = 0; i < num; i++) {
+        nrf24_stripe_txm_t *m = &members[i];
+        m->nrf24 = radios[i];
+        m->seq = 0;
+        m->fail_run = 0;
+        m->arc_avg = 0;
+        m->cur = 0;
+        m->tx_frames = 0;
+        m->max_rt = 0;
+        m->resets = 0;
+        rebalance(m);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Queue data for sending.
+ *
+ * @param len  1 ~ NRF24_STRIPE_MTU
+ * @return 0 on success, `NRF24_ERR_BUSY` if the send queue is full.
+ */
+int nrf24_stripe_send(nrf24_stripe_tx_t *tx, const uint8_t *data, uint8_t len)
+{
+    nrf24_stripe_slot_t *s;
+
+    CHECK(len > 0 && len <= NRF24_STRIPE_MTU);
+
+    if (tx->q_count >= tx->q_num) {
+        return NRF24_ERR_BUSY;
+    }
+
+    s = &tx->q[(tx->q_head + tx->q_count) % tx->q_num];
+    s->len = len;
+    for (int i = 0; i < len; i++) {
+        s->data[i] = data[i];
+    }
+    tx->q_count++;
+
+    return 0;
+}
+
+/// @return free TX FIFO entries (conservative)
+static int service_member(nrf24_stripe_tx_t *tx, nrf24_stripe_txm_t *m)
+{
+    nrf24_t *nrf24 = m->nrf24;
+    nrf24_fifosta_t fifosta;
+    int result;
+    int arc = -1;
+
+    result = nrf24_status_routine(nrf24, nrf24_read_and_clear_status(nrf24));
+    if (result & NRF24_STA_TX_FAIL) {
+        m->max_rt++;
+        arc = ARC_FAIL;
+        if (++m->fail_run >= tx->max_rt_limit) {
+            nrf24_txfifo_flush(nrf24); // frames lost, the receiver skips them
+            m->resets++;
+            m->fail_run = 0;
+        }
+        nrf24_clear_txfail_flag(nrf24);
+    } else if (result & NRF24_STA_TX_SENT) {
+        m->fail_run = 0;
+        arc = nrf24_read_observe(nrf24).arc_cnt; // of the last frame sent
+    }
+
+    if (arc >= 0) {
+        m->arc_avg += ((int32_t)arc * ARC_SCALE - m->arc_avg) / 8;
+        rebalance(m);
+    }
+
+    fifosta = nrf24_read_fifosta(nrf24);
+    if (fifosta.tx_empty) {
+        return 3;
+    }
+    return fifosta.tx_full ? 0 : 1;
+}
+
+/**
+ * @brief Service all members and distribute queued frames.
+ *
+ * @return Number of frames written to TX FIFOs.
+ */
+int nrf24_stripe_tx_poll(nrf24_stripe_tx_t *tx)
+{
+    uint8_t budget[NRF24_STRIPE_RADIOS_MAX];
+    uint8_t buf[32];
+    int n = 0;
+    int num = tx->num;
+
+    for (int i = 0; i < num; i++) {
+        budget[i] = service_member(tx, &tx->members[i]);
+    }
+
+    while (tx->q_count > 0) {
+        nrf24_stripe_slot_t *s = &tx->q[tx->q_head];
+        nrf24_stripe_txm_t *best = 0;
+        int32_t total = 0;
+        int bi = 0;
+
+        /* smooth weighted round-robin over members with FIFO space */
+        for (int i = 0; i < num; i++) {
+            nrf24_stripe_txm_t *m = &tx->members[i];
+            if (budget[i] == 0) {
+                continue;
+            }
+            m->cur += m->weight;
+            total += m->weight;
+            if (best == 0 || m->cur > best->cur) {
+                best = m;
+                bi = i;
+            }
+        }
+        if (best == 0) {
+            break;
+        }
+        best->cur -= total;
+
+        buf[0] = tx->seq;
+        buf[1] = best->seq;
+        for (int i = 0; i < s->len; i++) {
+            buf[NRF24_STRIPE_HDR_SIZE + i] = s->data[i];
+        }
+        if (nrf24_txfifo_ptx_write(best->nrf24, buf, NRF24_STRIPE_HDR_SIZE + s->len) != 0) {
+            budget[bi] = 0;
+            continue;
+        }
+
+        budget[bi]--;
+        best->seq++;
+        best->tx_frames++;
+        tx->seq++;
+        tx->q_head = (tx->q_head + 1) % tx->q_num;
+        tx->q_count--;
+        n++;
+    }
+
+    return n;
+}
+
+/************/
+/* Receiver */
+/************/
+
+/**
+ * @brief Initialize the receiving side (no I/O).
+ *
+ * @param members  Storage, one per radio.
+ * @param radios   Set-up PRX instances (see `nrf24_stripe_setup()`).
+ * @param rb       Reorder buffer storage.
+ * @param rb_num   Reorder buffer size, a power of two (1 ~ NRF24_STRIPE_REORDER_MAX) so that
+ *                 slot `seq % rb_num` stays consistent across the 8-bit sequence wrap.
+ * @return 0 on success.
+ *
+ * @note Set `on_data` (and optionally `now_ms`/`hol_timeout_ms`) afterwards.
+ */
+int nrf24_stripe_rx_init(nrf24_stripe_rx_t *rx, nrf24_stripe_rxm_t *members, nrf24_t **radios, uint8_t num,
+                         nrf24_stripe_rslot_t *rb, uint8_t rb_num)
+{
+    CHECK(rx != 0 && members != 0 && radios != 0 && num > 0);
+    CHECK(rb != 0 && rb_num > 0 && rb_num <= NRF24_STRIPE_REORDER_MAX && (rb_num & (rb_num - 1)) == 0);
+
+    rx->members = members;
+    rx->num = num;
+    rx->rb = rb;
+    rx->rb_num = rb_num;
+    rx->held = 0;
+    rx->expect = 0;
+    rx->synced = 0;
+    rx->now_ms = 0;
+    rx->hol_timeout_ms = 0;
+    rx->hol_since = 0;
+    rx->hol = 0;
+    rx->on_data = 0;
+    rx->user_data = 0;
+    rx->delivered = 0;
+    rx->skipped = 0;
+    rx->late = 0;
+
+    for (int i = 0; i < num; i++) {
+        members[i].nrf24 = radios[i];
+        members[i].expect = 0;
+        members[i].synced = 0;
+        members[i].rx_frames = 0;
+        members[i].lost = 0;
+    }
+
+    for (int i = 0; i < rb_num; i++) {
+        rb[i].used = 0;
+    }
+
+    return 0;
+}
+
+/// Deliver frames in order from the head of the reorder buffer
+static void deliver(nrf24_stripe_rx_t *rx)
+{
+    for (;;) {
+        nrf24_stripe_rslot_t *s = &rx->rb[rx->expect % rx->rb_num];
+        if (!s->used || s->seq != rx->expect) {
+            break;
+        }
+
+        s->used = 0;
+        rx->held--;
+        rx->expect++;
+        rx->delivered++;
+        rx->hol = 0;
+        if (rx->on_data != 0) {
+            rx->on_data(rx, s->data, s->len);
+        }
+    }
+}
+
+/// Give up on the missing head frame(s) up to the next held frame
+static void skip(nrf24_stripe_rx_t *rx)
+{
+    while (rx->held > 0) {
+        nrf24_stripe_rslot_t *s = &rx->rb[rx->expect % rx->rb_num];
+        if (s->used && s->seq == rx->expect) {
+            break;
+        }
+        rx->expect++;
+        rx->skipped++;
+    }
+
+    rx->hol = 0;
+    deliver(rx);
+}
+
+static void on_frame(nrf24_stripe_rx_t *rx, nrf24_stripe_rxm_t *m, const uint8_t *buf, uint8_t len)
+{
+    nrf24_stripe_rslot_t *s;
+    uint8_t seq = buf[0];
+    int8_t d;
+
+    if (len <= NRF24_STRIPE_HDR_SIZE) {
+        return;
+    }
+
+    /* per-member loss */
+    if (m->synced) {
+        m->lost += (uint8_t)(buf[1] - m->expect);
+    }
+    m->expect = buf[1] + 1;
+    m->synced = 1;
+    m->rx_frames++;
+
+    if (!rx->synced) {
+        rx->expect = seq;
+        rx->synced = 1;
+    }
+
+    d = (int8_t)(seq - rx->expect);
+    if (d < 0) {
+        rx->late++;
+        return;
+    }
+
+    /* out of the window: give up on the oldest missing frames */
+    while (d >= rx->rb_num) {
+        if (rx->held > 0) {
+            skip(rx);
+        } else {
+            rx->skipped += d - rx->rb_num + 1;
+            rx->expect += d - rx->rb_num + 1;
+        }
+        d = (int8_t)(seq - rx->expect);
+    }
+
+    s = &rx->rb[seq % rx->rb_num];
+    if (s->used) {
+        rx->late++;
+        return;
+    }
+
+    s->used = 1;
+    s->seq = seq;
+    s->len = len - NRF24_STRIPE_HDR_SIZE;
+    for (int i = 0; i < s->len; i++) {
+        s->data[i] = buf[NRF24_STRIPE_HDR_SIZE + i];
+    }
+    rx->held++;
+
+    deliver(rx);
+}
+
+/**
+ * @brief Drain all members and deliver what is in order.
+ *
+ * @return Number of frames received.
+ */
+int nrf24_stripe_rx_poll(nrf24_stripe_rx_t *rx)
+{
+    uint8_t buf[32];
+    uint8_t len;
+    int n = 0;
+
+    for (int i = 0; i < rx->num; i++) {
+        nrf24_stripe_rxm_t *m = &rx->members[i];
+
+        if (!(nrf24_status_routine(m->nrf24, nrf24_read_and_clear_status(m->nrf24)) & NRF24_STA_HAS_RXDATA)) {
+            continue;
+        }
+
+        while (nrf24_rxfifo_has_data(m->nrf24)) {
+            if (nrf24_rxfifo_read(m->nrf24, buf, &len, 0) != 0) {
+                break;
+            }
+            on_frame(rx, m, buf, len);
+            n++;
+        }
+    }
+
+    /* head-of-line timeout */
+    if (rx->held > 0 && rx->now_ms != 0 && rx->hol_timeout_ms != 0) {
+        uint32_t now = rx->now_ms();
+        if (!rx->hol) {
+            rx->hol = 1;
+            rx->hol_since = now;
+        } else if (now - rx->hol_since >= rx->hol_timeout_ms) {
+            skip(rx);
+        }
+    }
+
+    return n;
+}
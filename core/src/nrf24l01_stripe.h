@@ -0,0 +1,134 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_STRIPE_H
+#define NRF24L01_STRIPE_H
+
+#include "nrf24l01.h"
+
+/* Striped link aggregation across K radios
+ *
+ * One logical stream is spread over K PTX instances (each on its own channel)
+ * and collected by K PRX instances on the peer. Frame header (2 bytes):
+ *   [0] stream sequence number (reordering)
+ *   [1] member sequence number (per-radio loss accounting)
+ *
+ * The sender distributes frames by smooth weighted round-robin, weights being
+ * rebalanced from each member's retransmit rate (ARC, see `nrf24_read_observe()`).
+ * The receiver restores order with a bounded reorder buffer and skips missing
+ * frames when the buffer overflows or the head has been missing too long.
+ */
+
+#define NRF24_STRIPE_HDR_SIZE 2
+#define NRF24_STRIPE_MTU      (32 - NRF24_STRIPE_HDR_SIZE)
+#define NRF24_STRIPE_REORDER_MAX 64 // max reorder buffer size (stream sequence is 8-bit)
+#define NRF24_STRIPE_RADIOS_MAX  32 // max radios on the sending side
+
+typedef struct {
+    uint8_t len;
+    uint8_t data[NRF24_STRIPE_MTU];
+} nrf24_stripe_slot_t;
+
+/**********/
+/* Sender */
+/**********/
+
+typedef struct {
+    nrf24_t *nrf24;
+    uint8_t seq;         // next member sequence number
+    uint8_t fail_run;    // consecutive MAX_RT
+    uint16_t arc_avg;    // average retransmits per frame (x16, EWMA)
+    uint16_t weight;
+    int32_t cur;         // weighted round-robin state
+
+    // statistics
+    uint32_t tx_frames;
+    uint32_t max_rt;
+    uint32_t resets;
+} nrf24_stripe_txm_t;
+
+typedef struct {
+    nrf24_stripe_txm_t *members;
+    uint8_t num;
+
+    nrf24_stripe_slot_t *q;
+    uint8_t q_num;
+    uint8_t q_head;
+    uint8_t q_count;
+
+    uint8_t seq;          // next stream sequence number
+    uint8_t max_rt_limit; // consecutive MAX_RT before flushing a member (default 8)
+} nrf24_stripe_tx_t;
+
+int nrf24_stripe_tx_init(nrf24_stripe_tx_t *tx, nrf24_stripe_txm_t *members, nrf24_t **radios, uint8_t num,
+                         nrf24_stripe_slot_t *q, uint8_t q_num);
+int nrf24_stripe_send(nrf24_stripe_tx_t *tx, const uint8_t *data, uint8_t len);
+int nrf24_stripe_tx_poll(nrf24_stripe_tx_t *tx);
+
+/************/
+/* Receiver */
+/************/
+
+typedef struct nrf24_stripe_rx nrf24_stripe_rx_t;
+
+typedef struct {
+    nrf24_t *nrf24;
+    uint8_t expect; // next expected member sequence number
+    uint8_t synced;
+
+    // statistics
+    uint32_t rx_frames;
+    uint32_t lost;  // gaps in the member sequence
+} nrf24_stripe_rxm_t;
+
+typedef struct {
+    uint8_t used;
+    uint8_t seq;
+    uint8_t len;
+    uint8_t data[NRF24_STRIPE_MTU];
+} nrf24_stripe_rslot_t;
+
+struct nrf24_stripe_rx {
+    nrf24_stripe_rxm_t *members;
+    uint8_t num;
+
+    nrf24_stripe_rslot_t *rb; // reorder buffer
+    uint8_t rb_num;
+    uint8_t held;             // frames held in the reorder buffer
+    uint8_t expect;           // next stream sequence number to deliver
+    uint8_t synced;
+
+    // head-of-line timeout (optional, needs `now_ms`)
+    uint32_t (*now_ms)(void);
+    uint32_t hol_timeout_ms;
+    uint32_t hol_since;
+    uint8_t hol;
+
+    // in-order delivery, `data` is only valid during the call
+    void (*on_data)(nrf24_stripe_rx_t *rx, const uint8_t *data, uint8_t len);
+    void *user_data;
+
+    // statistics
+    uint32_t delivered;
+    uint32_t skipped;   // stream sequence numbers given up on
+    uint32_t late;      // duplicates or frames arriving after being skipped
+};
+
+int nrf24_stripe_rx_init(nrf24_stripe_rx_t *rx, nrf24_stripe_rxm_t *members, nrf24_t **radios, uint8_t num,
+                         nrf24_stripe_rslot_t *rb, uint8_t rb_num);
+int nrf24_stripe_rx_poll(nrf24_stripe_rx_t *rx);
+
+/*********/
+/* Setup */
+/*********/
+
+int nrf24_stripe_setup(nrf24_t **radios, uint8_t num, nrf24_role_enum_t role, const nrf24_user_cfg_t *ucfg, const uint8_t *channels);
+
+#endif // NRF24L01_STRIPE_H
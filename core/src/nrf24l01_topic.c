@@ -0,0 +1,191 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_topic.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+/**
+ * @brief Initialize a topic multiplexer (no I/O).
+ *
+ * @param pool      Pool the received packets are read into.
+ * @param subs      Storage for the subscriptions.
+ * @param num_subs  Max subscriptions (1..255).
+ * @return 0 on success.
+ */
+int nrf24_topic_init(nrf24_topic_t *mux, nrf24_t *nrf24, nrf24_pool_t *pool, nrf24_topic_sub_t *subs, uint8_t num_subs)
+{
+    CHECK(mux != 0 && nrf24 != 0 && pool != 0 && subs != 0);
+    CHECK(num_subs > 0 && num_subs < NRF24_TOPIC_NONE);
+
+    mux->nrf24 = nrf24;
+    mux->pool = pool;
+    mux->subs = subs;
+    mux->num_subs = num_subs;
+    mux->used = 0;
+
+    for (int i = 0; i < 256; i++) {
+        mux->map[i] = NRF24_TOPIC_NONE;
+    }
+
+    mux->stats.packets = 0;
+    mux->stats.unrouted = 0;
+    mux->stats.malformed = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Subscribe to a topic with a callback, a queue or both.
+ *
+ * @param q      Queue for a consumer thread, or NULL.
+ * @param depth  Max packets queued (0: queue capacity).
+ * @return 0 on success, NRF24_ERR_BUSY if the topic is taken or the table is full.
+ */
+int nrf24_topic_subscribe(nrf24_topic_t *mux, uint8_t topic, nrf24_topic_cb_t cb, void *user, nrf24_pktq_t *q, uint16_t depth)
+{
+    nrf24_topic_sub_t *sub;
+
+    CHECK(cb != 0 || q != 0);
+    CHECK(q == 0 || depth <= q->mask + 1);
+
+    if (mux->map[topic] != NRF24_TOPIC_NONE || mux->used >= mux->num_subs) {
+        return NRF24_ERR_BUSY;
+    }
+
+    sub = &mux->subs[mux->used];
+    sub->topic = topic;
+    sub->cb = cb;
+    sub->user = user;
+    sub->q = q;
+    sub->depth = (q != 0 && depth == 0) ? q->mask + 1 : depth;
+    sub->delivered = 0;
+    sub->dropped = 0;
+
+    mux->map[topic] = mux->used++;
+
+    return 0;
+}
+
+/**
+ * @brief Remove a subscription; packets already queued stay in its queue.
+ *
+ * @note Not safe against a concurrent `nrf24_topic_dispatch()`.
+ * @return 0 on success, -1 if the topic has no subscriber.
+ */
+int nrf24_topic_unsubscribe(nrf24_topic_t *mux, uint8_t topic)
+{
+    uint8_t idx = mux->map[topic];
+    uint8_t last;
+
+    if (idx == NRF24_TOPIC_NONE) {
+        return -1;
+    }
+
+    /* keep the table dense: move the last entry into the hole */
+    last = --mux->used;
+    if (idx != last) {
+        mux->subs[idx] = mux->subs[last];
+        mux->map[mux->subs[idx].topic] = idx;
+    }
+    mux->map[topic] = NRF24_TOPIC_NONE;
+
+    return 0;
+}
+
+/// Subscription of a topic (for its statistics), NULL if none.
+nrf24_topic_sub_t *nrf24_topic_sub(nrf24_topic_t *mux, uint8_t topic)
+{
+    uint8_t idx = mux->map[topic];
+
+    return idx == NRF24_TOPIC_NONE ? 0 : &mux->subs[idx];
+}
+
+static void route(nrf24_topic_t *mux, nrf24_pkt_t *pkt)
+{
+    nrf24_topic_sub_t *sub;
+    uint8_t idx;
+
+    if (pkt->len < 1) {
+        mux->stats.malformed++;
+        nrf24_pkt_unref(mux->pool, pkt);
+        return;
+    }
+
+    idx = mux->map[NRF24_TOPIC_OF(pkt)];
+    if (idx == NRF24_TOPIC_NONE) {
+        mux->stats.unrouted++;
+        nrf24_pkt_unref(mux->pool, pkt);
+        return;
+    }
+
+    sub = &mux->subs[idx];
+    sub->delivered++;
+    if (sub->cb != 0) {
+        sub->cb(mux, pkt, sub->user);
+    }
+
+    if (sub->q != 0) {
+        if (nrf24_pktq_count(sub->q) < sub->depth && nrf24_pktq_push(sub->q, pkt) == 0) {
+            return; // the queue owns our reference now
+        }
+        sub->delivered--;
+        sub->dropped++;
+    }
+
+    nrf24_pkt_unref(mux->pool, pkt);
+}
+
+/**
+ * @brief Read all received packets and route them to their subscribers.
+ *
+ * Runs from the RX event path (thread or ISR, as long as the callbacks allow it).
+ *
+ * @return Number of packets read.
+ */
+int nrf24_topic_dispatch(nrf24_topic_t *mux)
+{
+    nrf24_pkt_t *pkt;
+    int n = 0;
+
+    while ((pkt = nrf24_pkt_rx(mux->nrf24, mux->pool)) != 0) {
+        mux->stats.packets++;
+        route(mux, pkt);
+        n++;
+    }
+
+    return n;
+}
+
+/**
+ * @brief Send `[topic][data]` (see `nrf24_txfifo_write()`).
+ *
+ * @note Caller must ensure there is available(/free) TX FIFO
+ * @param len  0..NRF24_TOPIC_MTU.
+ * @return Zero on success, or negative error code on failure.
+ */
+int nrf24_topic_publish(nrf24_t *nrf24, uint8_t topic, const uint8_t *data, uint8_t len)
+{
+    uint8_t frame[32];
+
+    CHECK(len <= NRF24_TOPIC_MTU && (len == 0 || data != 0));
+
+    frame[0] = topic;
+    for (int i = 0; i < len; i++) {
+        frame[1 + i] = data[i];
+    }
+
+    return nrf24_txfifo_write(nrf24, frame, len + 1);
+}
@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_TOPIC_H
+#define NRF24L01_TOPIC_H
+
+#include "nrf24l01.h"
+#include "nrf24l01_pool.h"
+
+/* Publish/subscribe topics over one pipe
+ *
+ * Every packet starts with a one byte topic: `[topic][payload...]`.
+ * `nrf24_topic_dispatch()` reads packets into pool slots and routes each
+ * through a 256 entry topic map straight to its subscriber, so dispatch
+ * costs the same for 2 or 200 topics and consumers never see foreign
+ * packets.
+ *
+ * A subscriber gets the packet slot itself (no copy):
+ * - callback: called from the dispatch context (e.g. the RX event path);
+ *   take `nrf24_pkt_ref()` to keep the slot past the call.
+ * - queue: the slot is pushed to the subscriber's `nrf24_pktq_t` for a
+ *   consumer thread (which pops it and drops it with `nrf24_pkt_unref()`).
+ *   At `depth` queued packets further ones are dropped and counted.
+ * Both may be set; the callback runs first.
+ */
+
+#define NRF24_TOPIC_NONE 0xFF
+#define NRF24_TOPIC_MTU  31
+
+/* Payload view of a received topic packet */
+#define NRF24_TOPIC_OF(pkt)       ((pkt)->data[0])
+#define NRF24_TOPIC_DATA(pkt)     ((pkt)->data + 1)
+#define NRF24_TOPIC_LEN(pkt)      ((uint8_t)((pkt)->len - 1))
+
+typedef struct nrf24_topic nrf24_topic_t;
+
+typedef void (*nrf24_topic_cb_t)(nrf24_topic_t *mux, nrf24_pkt_t *pkt, void *user);
+
+typedef struct {
+    uint8_t topic;
+    nrf24_topic_cb_t cb;    // optional
+    void *user;
+    nrf24_pktq_t *q;        // optional
+    uint16_t depth;         // queue limit (<= queue capacity)
+
+    // statistics
+    uint32_t delivered;
+    uint32_t dropped;       // queue at depth
+} nrf24_topic_sub_t;
+
+typedef struct {
+    uint32_t packets;
+    uint32_t unrouted;      // no subscriber for the topic
+    uint32_t malformed;     // empty packet
+} nrf24_topic_stats_t;
+
+struct nrf24_topic {
+    nrf24_t *nrf24;
+    nrf24_pool_t *pool;
+    nrf24_topic_sub_t *subs;
+    uint8_t num_subs;
+    uint8_t used;
+    uint8_t map[256];       // topic -> index in `subs`, NRF24_TOPIC_NONE if unsubscribed
+
+    nrf24_topic_stats_t stats;
+};
+
+int nrf24_topic_init(nrf24_topic_t *mux, nrf24_t *nrf24, nrf24_pool_t *pool, nrf24_topic_sub_t *subs, uint8_t num_subs);
+int nrf24_topic_subscribe(nrf24_topic_t *mux, uint8_t topic, nrf24_topic_cb_t cb, void *user, nrf24_pktq_t *q, uint16_t depth);
+int nrf24_topic_unsubscribe(nrf24_topic_t *mux, uint8_t topic);
+nrf24_topic_sub_t *nrf24_topic_sub(nrf24_topic_t *mux, uint8_t topic);
+int nrf24_topic_dispatch(nrf24_topic_t *mux);
+int nrf24_topic_publish(nrf24_t *nrf24, uint8_t topic, const uint8_t *data, uint8_t len);
+
+#endif // NRF24L01_TOPIC_H
@@ -0,0 +1,83 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_TRACE_H
+#define NRF24L01_TRACE_H
+
+#include <stdint.h>
+
+/* Binary SPI trace format (shared by the driver and `utils/tracedec`)
+ *
+ * A dump is one `nrf24_trace_hdr_t` followed by `count` records, oldest first.
+ * All fields are little-endian.
+ */
+
+#define NRF24_TRACE_MAGIC0   'N'
+#define NRF24_TRACE_MAGIC1   'T'
+#define NRF24_TRACE_VERSION  1
+
+/* Pseudo commands (not valid SPI commands), used to record CE edges */
+#define NRF24_TRACE_CMD_CE_LOW   ((uint8_t)0xC0)
+#define NRF24_TRACE_CMD_CE_HIGH  ((uint8_t)0xC1)
+
+/* Record flags */
+#define NRF24_TRACE_FLAG_READ    ((uint8_t)(1 << 0)) // data was read from the device
+#define NRF24_TRACE_FLAG_ERR     ((uint8_t)(1 << 1)) // dep op returned non-zero
+
+#define NRF24_TRACE_DATA_MAX     4
+
+/* `status` value before the first STATUS read */
+#define NRF24_TRACE_STATUS_UNKNOWN ((uint8_t)0xFF)
+
+typedef struct {
+    // timestamp (NRF24L01_TRACE_TIMESTAMP ticks)
+    uint32_t ts;
+    // SPI command byte (register address included) or pseudo command
+    uint8_t cmd;
+    // data length (not including the command byte)
+    uint8_t len;
+    // last STATUS value seen by the driver
+    uint8_t status;
+    // NRF24_TRACE_FLAG_xxx
+    uint8_t flags;
+    // first data bytes
+    uint8_t data[NRF24_TRACE_DATA_MAX];
+} nrf24_trace_rec_t;
+
+typedef struct {
+    uint8_t magic[2];
+    uint8_t version;
+    // sizeof(nrf24_trace_rec_t)
+    uint8_t rec_size;
+    // timestamp frequency (ticks per second)
+    uint32_t ts_hz;
+    // number of records following the header
+    uint32_t count;
+    // number of records overwritten before the dump
+    uint32_t lost;
+} nrf24_trace_hdr_t;
+
+typedef struct nrf24_trace {
+    nrf24_trace_rec_t *recs;
+    // capacity - 1 (capacity is a power of two)
+    uint32_t mask;
+    // total number of records ever written
+    uint32_t seq;
+    // last STATUS value seen
+    uint8_t status;
+} nrf24_trace_t;
+
+/* Using C11 features to enhace checking */
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+    _Static_assert(sizeof(nrf24_trace_rec_t) == 12, "nrf24_trace_rec_t must be 12 bytes");
+    _Static_assert(sizeof(nrf24_trace_hdr_t) == 16, "nrf24_trace_hdr_t must be 16 bytes");
+#endif
+
+#endif // NRF24L01_TRACE_H
@@ -0,0 +1,323 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_tsync.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+#ifdef NRF24L01_ENABLE_TIMESTAMP
+
+/**
+ * @brief Initialize (no I/O).
+ *
+ * @param is_master  1: reference clock (PRX), 0: slave (PTX).
+ * @return 0 on success.
+ */
+int nrf24_tsync_init(nrf24_tsync_t *ts, nrf24_t *nrf24, uint8_t is_master)
+{
+    CHECK(ts != 0 && nrf24 != 0);
+
+    ts->nrf24 = nrf24;
+    ts->is_master = is_master;
+
+    ts->delay_comp_us = NRF24_TSTBY2A_US + 30;
+    ts->outlier_us = 1000;
+    ts->outlier_reset = 3;
+
+    ts->seq = 0;
+    for (int i = 0; i < 4; i++) {
+        ts->sent_seq[i] = 0;
+        ts->sent_us[i] = 0;
+    }
+    ts->is_request_pending = 0;
+
+    ts->num = 0;
+    ts->head = 0;
+    ts->outlier_streak = 0;
+    ts->ref_local = 0;
+    ts->ref_offset = 0;
+    ts->skew_ppb = 0;
+
+    ts->stats.samples = 0;
+    ts->stats.outliers = 0;
+    ts->stats.resets = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Master: handle a received frame; a sync request queues its stamp as ACK payload.
+ *
+ * Call right after reading the frame, before the RX_DR of a later one is
+ * seen (the stamp is `nrf24_rx_timestamp()`).
+ *
+ * @return 1 if the frame was a sync request, 0 otherwise.
+ */
+int nrf24_tsync_master_input(nrf24_tsync_t *ts, const uint8_t *data, uint8_t len, uint8_t pipe)
+{
+    uint8_t ack[6];
+    uint32_t t;
+
+    if (len != 2 || data[0] != NRF24_TSYNC_MAGIC) {
+        return 0;
+    }
+
+    t = nrf24_rx_timestamp(ts->nrf24);
+    ack[0] = NRF24_TSYNC_MAGIC;
+    ack[1] = data[1];
+    ack[2] = (uint8_t)t;
+    ack[3] = (uint8_t)(t >> 8);
+    ack[4] = (uint8_t)(t >> 16);
+    ack[5] = (uint8_t)(t >> 24);
+
+    if (!nrf24_txfifo_has_space(ts->nrf24)) {
+        return 1;
+    }
+    nrf24_txfifo_prx_write(ts->nrf24, ack, sizeof(ack), pipe);
+    ts->stats.samples++;
+
+    return 1;
+}
+
+/**
+ * @brief Slave: send a sync request (one at a time, call `nrf24_tsync_sent()` on its TX_DS).
+ *
+ * @return 0 on success, `NRF24_ERR_BUSY` if the previous request is still pending.
+ */
+int nrf24_tsync_request(nrf24_tsync_t *ts)
+{
+    uint8_t req[2];
+
+    if (ts->is_request_pending) {
+        return NRF24_ERR_BUSY;
+    }
+
+    req[0] = NRF24_TSYNC_MAGIC;
+    req[1] = ++ts->seq;
+    ts->is_request_pending = 1;
+
+    return nrf24_txfifo_ptx_write(ts->nrf24, req, sizeof(req));
+}
+
+/// Slave: the pending request was acknowledged, keep its stamp
+void nrf24_tsync_sent(nrf24_tsync_t *ts)
+{
+    uint8_t k;
+
+    if (!ts->is_request_pending) {
+        return;
+    }
+
+    k = ts->seq & 3;
+    ts->sent_seq[k] = ts->seq;
+    ts->sent_us[k] = nrf24_tx_timestamp(ts->nrf24);
+    ts->is_request_pending = 0;
+}
+
+/**
+ * @brief `num / den` (offset per 16 us) in ppb, clamped to int32_t.
+ *
+ * `num * 62500000` overflows once the table spans minutes, so the integer
+ * part is scaled separately and the remainder after narrowing `den`.
+ */
+static int32_t slope_ppb(int64_t num, int64_t den)
+{
+    int64_t q;
+    int64_t r;
+    int64_t ppb;
+
+    if (den < 0) {
+        num = -num;
+        den = -den;
+    }
+    /* |r| < den <= 2^36, r * 62500000 stays below 2^62 */
+    while (den > ((int64_t)1 << 36)) {
+        num /= 2;
+        den /= 2;
+    }
+
+    q = num / den;
+    r = num % den;
+    if (q > 64 || q < -64) {
+        return q > 0 ? INT32_MAX : INT32_MIN; // > 4e9 ppb, not a clock
+    }
+
+    ppb = q * 62500000 + r * 62500000 / den;
+    if (ppb > INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (ppb < INT32_MIN) {
+        return INT32_MIN;
+    }
+
+    return (int32_t)ppb;
+}
+
+/// Least squares fit of offset over local time
+static void fit(nrf24_tsync_t *ts)
+{
+    uint32_t ref_l = ts->loc[0];
+    uint32_t ref_o = ts->off[0];
+    int64_t sl = 0;
+    int64_t so = 0;
+    int64_t num = 0;
+    int64_t den = 0;
+    int32_t ml;
+    int32_t mo;
+
+    for (int i = 0; i < ts->num; i++) {
+        sl += (int32_t)(ts->loc[i] - ref_l);
+        so += (int32_t)(ts->off[i] - ref_o);
+    }
+    ml = (int32_t)(sl / ts->num);
+    mo = (int32_t)(so / ts->num);
+
+    /* local deltas in 16 us units keep the sums in range */
+    for (int i = 0; i < ts->num; i++) {
+        int64_t dl = ((int32_t)(ts->loc[i] - ref_l) - ml) / 16;
+        int64_t dof = (int32_t)(ts->off[i] - ref_o) - mo;
+        num += dl * dof;
+        den += dl * dl;
+    }
+
+    ts->ref_local = ref_l + ml;
+    ts->ref_offset = ref_o + mo;
+    ts->skew_ppb = den != 0 ? slope_ppb(num, den) : 0;
+}
+
+/**
+ * @brief Slave: handle an ACK payload; a sync answer adds a sample.
+ *
+ * @return 1 if the payload was a sync answer, 0 otherwise.
+ */
+int nrf24_tsync_slave_input(nrf24_tsync_t *ts, const uint8_t *data, uint8_t len)
+{
+    uint8_t k;
+    uint32_t m;
+    uint32_t l;
+    uint32_t o;
+
+    if (len != 6 || data[0] != NRF24_TSYNC_MAGIC) {
+        return 0;
+    }
+
+    k = data[1] & 3;
+    if (ts->sent_seq[k] != data[1]) {
+        return 1; // stamp of the request is gone
+    }
+
+    m = data[2] | (data[3] << 8) | ((uint32_t)data[4] << 16) | ((uint32_t)data[5] << 24);
+    l = ts->sent_us[k];
+    o = m + ts->delay_comp_us - l;
+    ts->sent_seq[k] = (uint8_t)(data[1] + 1); // consume
+
+    if (nrf24_tsync_is_synced(ts)) {
+        int32_t err = (int32_t)(nrf24_tsync_global(ts, l) - (l + o));
+        if (err > (int32_t)ts->outlier_us || -err > (int32_t)ts->outlier_us) {
+            ts->stats.outliers++;
+            if (++ts->outlier_streak < ts->outlier_reset) {
+                return 1;
+            }
+            ts->num = 0; // the reference moved (e.g. master reset), start over
+            ts->head = 0;
+            ts->stats.resets++;
+        }
+    }
+    ts->outlier_streak = 0;
+
+    if (ts->num < NRF24_TSYNC_TABLE) {
+        ts->loc[ts->num] = l;
+        ts->off[ts->num] = o;
+        ts->num++;
+    }else {
+        ts->loc[ts->head] = l;
+        ts->off[ts->head] = o;
+        ts->head = (ts->head + 1) % NRF24_TSYNC_TABLE;
+    }
+    ts->stats.samples++;
+
+    fit(ts);
+
+    return 1;
+}
+
+/**
+ * @brief Handle status and RX for a link dedicated to time sync.
+ *
+ * Master: answers requests. Slave: records stamps and samples (call
+ * `nrf24_tsync_request()` periodically). Other frames are dropped.
+ *
+ * @return Number of sync frames handled.
+ */
+int nrf24_tsync_poll(nrf24_tsync_t *ts)
+{
+    nrf24_t *nrf24 = ts->nrf24;
+    uint8_t buf[32];
+    uint8_t len;
+    uint8_t pipe;
+    int result;
+    int n = 0;
+
+    result = nrf24_status_routine(nrf24, nrf24_read_and_clear_status(nrf24));
+
+    if (result & NRF24_STA_TX_FAIL) {
+        nrf24_txfifo_flush(nrf24);
+        nrf24_clear_txfail_flag(nrf24);
+        ts->is_request_pending = 0;
+    }
+    if (result & NRF24_STA_TX_SENT) {
+        nrf24_tsync_sent(ts);
+    }
+
+    while (nrf24_rxfifo_has_data(nrf24)) {
+        if (nrf24_rxfifo_read(nrf24, buf, &len, &pipe) != 0) {
+            break;
+        }
+        if (ts->is_master) {
+            n += nrf24_tsync_master_input(ts, buf, len, pipe);
+        }else {
+            n += nrf24_tsync_slave_input(ts, buf, len);
+        }
+    }
+
+    return n;
+}
+
+/// @return `true` once enough samples are in the table
+int nrf24_tsync_is_synced(const nrf24_tsync_t *ts)
+{
+    return ts->is_master || ts->num >= NRF24_TSYNC_MIN_ENTRIES;
+}
+
+/**
+ * @brief Convert a local time to the master's time.
+ *
+ * @param local_us  Local time (e.g. `nrf24_rx_timestamp()`).
+ * @return Global time in us (the local time itself on the master).
+ */
+uint32_t nrf24_tsync_global(const nrf24_tsync_t *ts, uint32_t local_us)
+{
+    int64_t dl;
+
+    if (ts->is_master || ts->num == 0) {
+        return local_us;
+    }
+
+    dl = (int32_t)(local_us - ts->ref_local);
+
+    return local_us + ts->ref_offset + (int32_t)(dl * ts->skew_ppb / 1000000000);
+}
+
+#endif // NRF24L01_ENABLE_TIMESTAMP
@@ -0,0 +1,83 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_TSYNC_H
+#define NRF24L01_TSYNC_H
+
+#include "nrf24l01.h"
+
+/* Time sync over ACK payloads (FTSP-style, needs NRF24L01_ENABLE_TIMESTAMP)
+ *
+ * The master (PRX) holds the reference clock. A slave (PTX) sends a sync
+ * request; the master stamps its arrival (RX_DR) and queues that time as the
+ * ACK payload, so it comes back with the slave's *next* request. The slave
+ * pairs it with its own stamp of the same request (TX_DS, i.e. the ACK
+ * arrival) and feeds (local, offset) into a small regression table; offset
+ * and skew are fitted over the table, outliers are dropped.
+ *
+ * Frames:
+ * - request: [NRF24_TSYNC_MAGIC, seq]
+ * - ACK:     [NRF24_TSYNC_MAGIC, seq of the stamped request, rx_us (4, LE)]
+ *
+ * Stamp in the IRQ handler (`nrf24_irq_stamp()`) on both sides for
+ * microsecond-level results.
+ */
+
+#define NRF24_TSYNC_MAGIC 0xA7
+#define NRF24_TSYNC_TABLE 8
+#define NRF24_TSYNC_MIN_ENTRIES 3
+
+typedef struct {
+    uint32_t samples;
+    uint32_t outliers;
+    uint32_t resets;
+} nrf24_tsync_stats_t;
+
+typedef struct {
+    nrf24_t *nrf24;
+    uint8_t is_master;
+
+    // parameters (defaults set by `nrf24_tsync_init()`)
+    int32_t delay_comp_us;    // master RX_DR -> slave TX_DS, default Tstby2a + ACK airtime
+    uint32_t outlier_us;      // reject samples this far off the fit, default 1000
+    uint8_t outlier_reset;    // consecutive outliers that restart the table, default 3
+
+    // slave: stamps of sent requests
+    uint8_t seq;
+    uint8_t sent_seq[4];
+    uint32_t sent_us[4];
+    uint8_t is_request_pending;
+
+    // regression table
+    uint32_t loc[NRF24_TSYNC_TABLE];
+    uint32_t off[NRF24_TSYNC_TABLE];
+    uint8_t num;
+    uint8_t head;
+    uint8_t outlier_streak;
+
+    // fit: global = local + offset + skew_ppb * (local - ref_local) / 1e9
+    uint32_t ref_local;
+    uint32_t ref_offset;
+    int32_t skew_ppb;
+
+    nrf24_tsync_stats_t stats;
+} nrf24_tsync_t;
+
+int nrf24_tsync_init(nrf24_tsync_t *ts, nrf24_t *nrf24, uint8_t is_master);
+int nrf24_tsync_master_input(nrf24_tsync_t *ts, const uint8_t *data, uint8_t len, uint8_t pipe);
+int nrf24_tsync_request(nrf24_tsync_t *ts);
+void nrf24_tsync_sent(nrf24_tsync_t *ts);
+int nrf24_tsync_slave_input(nrf24_tsync_t *ts, const uint8_t *data, uint8_t len);
+int nrf24_tsync_poll(nrf24_tsync_t *ts);
+
+int nrf24_tsync_is_synced(const nrf24_tsync_t *ts);
+uint32_t nrf24_tsync_global(const nrf24_tsync_t *ts, uint32_t local_us);
+
+#endif // NRF24L01_TSYNC_H
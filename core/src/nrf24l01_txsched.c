@@ -0,0 +1,311 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#include "nrf24l01_txsched.h"
+#include "./internal/cfg.h"
+#include "./internal/log.h"
+
+#ifdef CHECK
+#undef CHECK
+#endif
+#define CHECK NRF24_CHECK
+
+/**
+ * @brief Initialize a scheduler (no I/O), strict priority with depth 1 by default.
+ *
+ * @param pool    Pool the queued packets come from (for releasing them).
+ * @param levels  Storage, one per priority level; set each up with `nrf24_txsched_level_init()`.
+ * @return 0 on success.
+ */
+int nrf24_txsched_init(nrf24_txsched_t *s, nrf24_t *nrf24, nrf24_pool_t *pool, nrf24_txsched_level_t *levels, uint8_t num_levels)
+{
+    CHECK(s != 0 && nrf24 != 0 && pool != 0 && levels != 0 && num_levels > 0);
+
+    s->nrf24 = nrf24;
+    s->pool = pool;
+    s->levels = levels;
+    s->num_levels = num_levels;
+    s->policy = NRF24_TXSCHED_STRICT;
+    s->depth = 1;
+    s->inflight_n = 0;
+    s->sent = 0;
+    s->failed = 0;
+    s->preempts = 0;
+    s->requeued = 0;
+
+    for (int i = 0; i < num_levels; i++) {
+        levels[i].slots = 0;
+        levels[i].num = 0;
+        levels[i].head = 0;
+        levels[i].count = 0;
+        levels[i].weight = 1;
+        levels[i].credit = 0;
+        levels[i].enqueued = 0;
+        levels[i].sent = 0;
+        levels[i].dropped = 0;
+    }
+
+    return 0;
+}
+
+/**
+ * @param slots   Queue storage.
+ * @param weight  Packets per round in WEIGHTED mode (>= 1).
+ */
+int nrf24_txsched_level_init(nrf24_txsched_t *s, uint8_t level, nrf24_pkt_t **slots, uint8_t num, uint8_t weight)
+{
+    nrf24_txsched_level_t *l;
+
+    CHECK(level < s->num_levels && slots != 0 && num > 0 && weight > 0);
+
+    l = &s->levels[level];
+    l->slots = slots;
+    l->num = num;
+    l->head = 0;
+    l->count = 0;
+    l->weight = weight;
+    l->credit = weight;
+
+    return 0;
+}
+
+/**
+ * @param policy  NRF24_TXSCHED_STRICT or NRF24_TXSCHED_WEIGHTED
+ * @param depth   Max packets in the hardware FIFO (1-3)
+ */
+int nrf24_txsched_set_policy(nrf24_txsched_t *s, uint8_t policy, uint8_t depth)
+{
+    CHECK(policy <= NRF24_TXSCHED_WEIGHTED && depth >= 1 && depth <= 3);
+
+    s->policy = policy;
+    s->depth = depth;
+
+    return 0;
+}
+
+/**
+ * @brief Queue a packet; the scheduler takes over the caller's reference.
+ *
+ * @return 0 on success, `NRF24_ERR_BUSY` if the level is full (caller keeps the reference).
+ */
+int nrf24_txsched_enqueue(nrf24_txsched_t *s, uint8_t level, nrf24_pkt_t *pkt)
+{
+    nrf24_txsched_level_t *l;
+
+    CHECK(level < s->num_levels && pkt != 0);
+
+    l = &s->levels[level];
+    if (l->count >= l->num) {
+        l->dropped++;
+        return NRF24_ERR_BUSY;
+    }
+
+    l->slots[(l->head + l->count) % l->num] = pkt;
+    l->count++;
+    l->enqueued++;
+
+    return 0;
+}
+
+static void push_front(nrf24_txsched_level_t *l, nrf24_pkt_t *pkt)
+{
+    l->head = (l->head + l->num - 1) % l->num;
+    l->slots[l->head] = pkt;
+    l->count++;
+}
+
+static nrf24_pkt_t *pop_front(nrf24_txsched_level_t *l)
+{
+    nrf24_pkt_t *pkt = l->slots[l->head];
+    l->head = (l->head + 1) % l->num;
+    l->count--;
+    return pkt;
+}
+
+/// @return level to serve next, -1 if all empty
+static int pick_level(nrf24_txsched_t *s)
+{
+    int any = -1;
+
+    for (int i = 0; i < s->num_levels; i++) {
+        nrf24_txsched_level_t *l = &s->levels[i];
+        if (l->count == 0) {
+            continue;
+        }
+        if (s->policy == NRF24_TXSCHED_STRICT) {
+            return i;
+        }
+        if (any < 0) {
+            any = i;
+        }
+        if (l->credit > 0) {
+            l->credit--;
+            return i;
+        }
+    }
+
+    if (any < 0) {
+        return -1;
+    }
+
+    /* round over: refill */
+    for (int i = 0; i < s->num_levels; i++) {
+        s->levels[i].credit = s->levels[i].weight;
+    }
+    s->levels[any].credit--;
+
+    return any;
+}
+
+static void complete(nrf24_txsched_t *s, int n)
+{
+    for (int i = 0; i < n && s->inflight_n > 0; i++) {
+        nrf24_pkt_unref(s->pool, s->inflight[0]);
+        s->levels[s->inflight_level[0]].sent++;
+        s->sent++;
+        s->inflight[0] = s->inflight[1];
+        s->inflight[1] = s->inflight[2];
+        s->inflight_level[0] = s->inflight_level[1];
+        s->inflight_level[1] = s->inflight_level[2];
+        s->inflight_n--;
+    }
+}
+
+/**
+ * @brief Retire completed packets, rebuilding the count from the hardware FIFO level.
+ *
+ * TX_DS events merge between polls, so they only tell that at least one packet
+ * completed. The FIFO level is known exactly when empty or full, and is 1 ~ 2 otherwise
+ * (assume 2, a later poll catches up once the level is known again).
+ */
+static void sync_inflight(nrf24_txsched_t *s, nrf24_fifosta_t fifosta, int tx_sent)
+{
+    uint8_t level = fifosta.tx_empty ? 0 : fifosta.tx_full ? 3 : 2;
+    uint8_t target = s->inflight_n;
+
+    if (tx_sent && target > 0) {
+        target--;
+    }
+    if (target > level) {
+        target = level;
+    }
+
+    complete(s, s->inflight_n - target);
+}
+
+/// Put what is in the hardware FIFO back at the head of the queues (newest first, to keep order)
+static void requeue_inflight(nrf24_txsched_t *s)
+{
+    while (s->inflight_n > 0) {
+        uint8_t k = --s->inflight_n;
+        nrf24_txsched_level_t *l = &s->levels[s->inflight_level[k]];
+
+        if (l->count < l->num) {
+            push_front(l, s->inflight[k]);
+            s->requeued++;
+        } else {
+            nrf24_pkt_unref(s->pool, s->inflight[k]);
+            l->dropped++;
+        }
+    }
+}
+
+/**
+ * @brief Account TX results and top the hardware FIFO up to `depth`.
+ *
+ * On MAX_RT the failed packet is dropped and the rest of the hardware FIFO is requeued.
+ *
+ * @return Number of packets written to the hardware FIFO.
+ */
+int nrf24_txsched_service(nrf24_txsched_t *s)
+{
+    nrf24_t *nrf24 = s->nrf24;
+    nrf24_fifosta_t fifosta;
+    int result;
+    int n = 0;
+
+    result = nrf24_status_routine(nrf24, nrf24_read_and_clear_status(nrf24));
+
+    if (s->inflight_n > 0) {
+        fifosta = nrf24_read_fifosta(nrf24);
+        sync_inflight(s, fifosta, result & NRF24_STA_TX_SENT);
+    }
+
+    if (result & NRF24_STA_TX_FAIL) {
+        /* the head of the hardware FIFO is the failed packet */
+        nrf24_txfifo_flush(nrf24);
+        if (s->inflight_n > 0) {
+            nrf24_pkt_unref(s->pool, s->inflight[0]);
+            s->failed++;
+            s->inflight[0] = s->inflight[1];
+            s->inflight[1] = s->inflight[2];
+            s->inflight_level[0] = s->inflight_level[1];
+            s->inflight_level[1] = s->inflight_level[2];
+            s->inflight_n--;
+        }
+        requeue_inflight(s);
+        nrf24_clear_txfail_flag(nrf24);
+    }
+
+    while (s->inflight_n < s->depth) {
+        int lv = pick_level(s);
+        nrf24_pkt_t *pkt;
+
+        if (lv < 0) {
+            break;
+        }
+
+        pkt = pop_front(&s->levels[lv]);
+        if (nrf24_pkt_tx(nrf24, pkt) != 0) {
+            push_front(&s->levels[lv], pkt);
+            break;
+        }
+
+        s->inflight[s->inflight_n] = pkt;
+        s->inflight_level[s->inflight_n] = lv;
+        s->inflight_n++;
+        n++;
+    }
+
+    return n;
+}
+
+/**
+ * @brief Emergency: flush the hardware FIFO and requeue its packets, then refill.
+ *
+ * Use after enqueueing an urgent packet so it does not wait behind the
+ * hardware FIFO.
+ *
+ * @return Number of packets written to the hardware FIFO.
+ *
+ * @attention A flushed packet may already have been delivered (ACK in flight), it is then sent twice.
+ */
+int nrf24_txsched_preempt(nrf24_txsched_t *s)
+{
+    if (s->inflight_n > 0) {
+        nrf24_txfifo_flush(s->nrf24);
+        requeue_inflight(s);
+        s->preempts++;
+    }
+
+    return nrf24_txsched_service(s);
+}
+
+/// @return Number of packets queued or in the hardware FIFO
+int nrf24_txsched_pending(const nrf24_txsched_t *s)
+{
+    int n = s->inflight_n;
+
+    for (int i = 0; i < s->num_levels; i++) {
+        n += s->levels[i].count;
+    }
+
+    return n;
+}
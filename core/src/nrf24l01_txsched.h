@@ -0,0 +1,77 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Copyright sogwms
+ * 
+ * Change Logs:
+ * Date           Author       Notes
+ * 2025-07-26     sogwms       first version       
+ */
+
+#ifndef NRF24L01_TXSCHED_H
+#define NRF24L01_TXSCHED_H
+
+#include "nrf24l01.h"
+#include "nrf24l01_pool.h"
+
+/* Multi-priority TX scheduler (PTX)
+ *
+ * Packets (pool slots) wait in software queues, one per priority level
+ * (0 is the highest), and are fed to the hardware TX FIFO only up to `depth`
+ * entries: what is inside the chip can no longer be overtaken, so a small
+ * depth keeps the latency of urgent packets low at some cost in throughput.
+ *
+ * Service is strict priority or weighted round-robin (`weight` packets per
+ * level per round). `nrf24_txsched_preempt()` flushes the hardware FIFO and
+ * puts its packets back at the head of their queues.
+ *
+ * @note Not thread-safe, use from one context.
+ */
+
+#define NRF24_TXSCHED_STRICT   0
+#define NRF24_TXSCHED_WEIGHTED 1
+
+typedef struct {
+    nrf24_pkt_t **slots;
+    uint8_t num;
+    uint8_t head;
+    uint8_t count;
+    uint8_t weight; // WEIGHTED: packets per round
+    uint8_t credit;
+
+    // statistics
+    uint32_t enqueued;
+    uint32_t sent;
+    uint32_t dropped; // queue full on enqueue
+} nrf24_txsched_level_t;
+
+typedef struct {
+    nrf24_t *nrf24;
+    nrf24_pool_t *pool;
+
+    nrf24_txsched_level_t *levels;
+    uint8_t num_levels;
+    uint8_t policy; // NRF24_TXSCHED_STRICT | NRF24_TXSCHED_WEIGHTED
+    uint8_t depth;  // max packets in the hardware FIFO (1-3)
+
+    // hardware FIFO contents, oldest first
+    nrf24_pkt_t *inflight[3];
+    uint8_t inflight_level[3];
+    uint8_t inflight_n;
+
+    // statistics
+    uint32_t sent;
+    uint32_t failed;   // MAX_RT, packet dropped
+    uint32_t preempts;
+    uint32_t requeued;
+} nrf24_txsched_t;
+
+int nrf24_txsched_init(nrf24_txsched_t *s, nrf24_t *nrf24, nrf24_pool_t *pool, nrf24_txsched_level_t *levels, uint8_t num_levels);
+int nrf24_txsched_level_init(nrf24_txsched_t *s, uint8_t level, nrf24_pkt_t **slots, uint8_t num, uint8_t weight);
+int nrf24_txsched_set_policy(nrf24_txsched_t *s, uint8_t policy, uint8_t depth);
+int nrf24_txsched_enqueue(nrf24_txsched_t *s, uint8_t level, nrf24_pkt_t *pkt);
+int nrf24_txsched_service(nrf24_txsched_t *s);
+int nrf24_txsched_preempt(nrf24_txsched_t *s);
+int nrf24_txsched_pending(const nrf24_txsched_t *s);
+
+#endif // NRF24L01_TXSCHED_H
@@ -0,0 +1,298 @@
+
+/**
+ * @brief Modify bits of a mirrored register.
+ *
+ * Uses the cached value when the shadow is valid (one write, or none if the
+ * value is unchanged), falls back to read-modify-write otherwise.
+ */
+static int shadow_modify_bits(nrf24_t *nrf24, uint8_t reg, uint8_t mask, uint8_t value)
+{
+    int ret;
+    uint8_t byte;
+
+    if (!nrf24->is_shadow_valid) {
+        return reg_modify_bits(&nrf24->dep, reg, mask, value);
+    }
+
+    byte = nrf24->shadow.regs[reg];
+    byte_set_bits(&byte, mask, value);
+    if (byte == nrf24->shadow.regs[reg]) {
+        return 0;
+    }
+
+    ret = write_reg(&nrf24->dep, reg, byte);
+    if (ret == 0) {
+        nrf24->shadow.regs[reg] = byte;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Keep the shadow in sync with a raw register write.
+ */
+static void shadow_note_write(nrf24_t *nrf24, uint8_t reg, const uint8_t *vals, uint8_t len)
+{
+    if (!nrf24->is_shadow_valid || len == 0) {
+        return;
+    }
+
+    if (reg == NRF24_REG_RX_ADDR_P0) {
+        copy(nrf24->shadow.rx_addr_p0, vals, len < 5 ? len : 5);
+    } else if (reg == NRF24_REG_RX_ADDR_P1) {
+        copy(nrf24->shadow.rx_addr_p1, vals, len < 5 ? len : 5);
+    } else if (reg == NRF24_REG_TX_ADDR) {
+        copy(nrf24->shadow.tx_addr, vals, len < 5 ? len : 5);
+    } else if (reg < NRF24_REGFILE_SIZE) {
+        nrf24->shadow.regs[reg] = vals[0];
+    }
+}
+
+/**
+ * @brief Re-read the cached configuration registers from the device.
+ *
+ * @note Needed only if the device was reconfigured behind the driver's back (e.g. brown-out).
+ */
+int nrf24_cfg_resync(nrf24_t *nrf24)
+{
+    int ret;
+
+    LOCK(nrf24);
+    ret = regfile_read(&nrf24->dep, &nrf24->shadow);
+    nrf24->is_shadow_valid = ret == 0;
+    UNLOCK(nrf24);
+
+    return ret;
+}
+
+#define TXN_ADDR_P0 0x01
+#define TXN_ADDR_P1 0x02
+#define TXN_ADDR_TX 0x04
+
+/// Stage `value` into the `mask` bits of a register
+static void txn_set_bits(nrf24_cfg_txn_t *txn, uint8_t reg, uint8_t mask, uint8_t value)
+{
+    byte_set_bits(&txn->regs.regs[reg], mask, value);
+    txn->staged[reg] |= mask;
+}
+
+/**
+ * @brief Begin a configuration transaction.
+ *
+ * Changes are staged with `nrf24_cfg_set_xxx()` against the cached register
+ * image (no I/O) and written by `nrf24_cfg_commit()`.
+ *
+ * @param nrf24  Pointer to the NRF24 device instance.
+ * @param txn    Transaction to initialize.
+ * @return       0 on success, non-zero on error.
+ *
+ * @note Reads the configuration registers once if they are not cached yet.
+ */
+int nrf24_cfg_begin(nrf24_t *nrf24, nrf24_cfg_txn_t *txn)
+{
+    int ret = 0;
+
+    LOCK(nrf24);
+    if (!nrf24->is_shadow_valid) {
+        ret = nrf24_cfg_resync(nrf24);
+    }
+
+    copy(&txn->regs, &nrf24->shadow, sizeof(txn->regs));
+    clear_object(txn->staged, sizeof(txn->staged));
+    txn->staged_addrs = 0;
+    UNLOCK(nrf24);
+
+    return ret;
+}
+
+int nrf24_cfg_set_channel(nrf24_cfg_txn_t *txn, uint8_t channel)
+{
+    CHECK(channel <= 125);
+    txn_set_bits(txn, NRF24_REG_RF_CH, REG_RF_CH_BITMASK_RF_CH, channel);
+    return 0;
+}
+
+int nrf24_cfg_set_rf_power(nrf24_cfg_txn_t *txn, nrf24_rfpower_enum_t power)
+{
+    CHECK(power <= NRF24_RF_POWER_0dBm);
+    txn_set_bits(txn, NRF24_REG_RF_SETUP, REG_RF_SETUP_BITMASK_RF_PWR, power);
+    return 0;
+}
+
+int nrf24_cfg_set_adr(nrf24_cfg_txn_t *txn, nrf24_adr_enum_t adr)
+{
+    CHECK(adr <= NRF24_ADR_2Mbps);
+    txn_set_bits(txn, NRF24_REG_RF_SETUP, REG_RF_SETUP_BITMASK_RF_DR, adr);
+    return 0;
+}
+
+/**
+ * @param addr  address (LSB first), the configured width (3-5 bytes)
+ *
+ * @note Stage a width change (`nrf24_cfg_set_addr_width()`) before the addresses.
+ */
+int nrf24_cfg_set_tx_addr(nrf24_cfg_txn_t *txn, const uint8_t *addr)
+{
+    copy(txn->regs.tx_addr, addr, regfile_aw(&txn->regs));
+    txn->staged_addrs |= TXN_ADDR_TX;
+    return 0;
+}
+
+/**
+ * @param pipe  0-5
+ * @param addr  pipe 0-1: address (LSB first, the configured width); pipe 2-5: 1 byte (LSB)
+ */
+int nrf24_cfg_set_rx_addr(nrf24_cfg_txn_t *txn, uint8_t pipe, const uint8_t *addr)
+{
+    CHECK(pipe <= 5);
+
+    if (pipe == 0) {
+        copy(txn->regs.rx_addr_p0, addr, regfile_aw(&txn->regs));
+        txn->staged_addrs |= TXN_ADDR_P0;
+    } else if (pipe == 1) {
+        copy(txn->regs.rx_addr_p1, addr, regfile_aw(&txn->regs));
+        txn->staged_addrs |= TXN_ADDR_P1;
+    } else {
+        txn_set_bits(txn, NRF24_REG_RX_ADDR_P0 + pipe, 0xFF, addr[0]);
+    }
+
+    return 0;
+}
+
+int nrf24_cfg_set_rxpipe(nrf24_cfg_txn_t *txn, uint8_t pipe, uint8_t enable, uint8_t enable_aa)
+{
+    CHECK(pipe <= 5);
+    txn_set_bits(txn, NRF24_REG_EN_RXADDR, BITMASK_PIPE_0 << pipe, enable ? 1 : 0);
+    txn_set_bits(txn, NRF24_REG_EN_AA, BITMASK_PIPE_0 << pipe, enable_aa ? 1 : 0);
+    return 0;
+}
+
+/**
+ * @param ard  auto retransmit delay, (ard + 1) * 250us (0-15)
+ * @param arc  auto retransmit count (0-15)
+ */
+int nrf24_cfg_set_retr(nrf24_cfg_txn_t *txn, uint8_t ard, uint8_t arc)
+{
+    CHECK(ard <= 15 && arc <= 15);
+    txn_set_bits(txn, NRF24_REG_SETUP_RETR, REG_SETUP_RETR_BITMASK_ARD, ard);
+    txn_set_bits(txn, NRF24_REG_SETUP_RETR, REG_SETUP_RETR_BITMASK_ARC, arc);
+    return 0;
+}
+
+int nrf24_cfg_set_addr_width(nrf24_cfg_txn_t *txn, nrf24_aw_enum_t aw)
+{
+    CHECK(aw >= NRF24_AW_3BYTES && aw <= NRF24_AW_5BYTES);
+    txn_set_bits(txn, NRF24_REG_SETUP_AW, REG_AW_BITMASK_AW, aw);
+    return 0;
+}
+
+int nrf24_cfg_set_crc(nrf24_cfg_txn_t *txn, nrf24_crc_enum_t crc)
+{
+    CHECK(crc == NRF24_CRC_OFF || crc == NRF24_CRC_1BYTE || crc == NRF24_CRC_2BYTES);
+    txn_set_bits(txn, NRF24_REG_CONFIG, CONFIG_BITMASK_CRC, crc_bits(crc));
+    return 0;
+}
+
+/**
+ * @brief Stage a whole user config.
+ */
+void nrf24_cfg_apply_usercfg(nrf24_cfg_txn_t *txn, const nrf24_user_cfg_t *ucfg)
+{
+    regfile_apply_usercfg(&txn->regs, ucfg);
+
+    /* the fields `regfile_apply_usercfg()` sets */
+    txn->staged[NRF24_REG_RF_SETUP] |= REG_RF_SETUP_BITMASK_RF_DR | REG_RF_SETUP_BITMASK_RF_PWR;
+    txn->staged[NRF24_REG_RF_CH] = 0xFF;
+    txn->staged[NRF24_REG_EN_RXADDR] = 0xFF;
+    txn->staged[NRF24_REG_EN_AA] = 0xFF;
+    txn->staged[NRF24_REG_SETUP_AW] |= REG_AW_BITMASK_AW;
+    txn->staged[NRF24_REG_CONFIG] |= CONFIG_BITMASK_CRC;
+    for (int i = 2; i < 6; i++) {
+        txn->staged[NRF24_REG_RX_ADDR_P0 + i] = 0xFF;
+    }
+    txn->staged_addrs = TXN_ADDR_P0 | TXN_ADDR_P1 | TXN_ADDR_TX;
+}
+
+/**
+ * @brief Merge the staged fields of a transaction onto the current image.
+ *
+ * Everything else (e.g. CONFIG PRIM_RX/PWR_UP changed by role or power
+ * calls since `nrf24_cfg_begin()`) is kept as it is now.
+ */
+static void txn_merge(const nrf24_cfg_txn_t *txn, const nrf24_regfile_t *cur, nrf24_regfile_t *want)
+{
+    copy(want, cur, sizeof(*want));
+
+    for (int i = 0; i < REGFILE_REGS_NUM; i++) {
+        uint8_t reg = g_regfile_regs[i];
+        uint8_t mask = txn->staged[reg];
+        want->regs[reg] = (uint8_t)((cur->regs[reg] & ~mask) | (txn->regs.regs[reg] & mask));
+    }
+
+    if (txn->staged_addrs & TXN_ADDR_P0) {
+        copy(want->rx_addr_p0, txn->regs.rx_addr_p0, 5);
+    }
+    if (txn->staged_addrs & TXN_ADDR_P1) {
+        copy(want->rx_addr_p1, txn->regs.rx_addr_p1, 5);
+    }
+    if (txn->staged_addrs & TXN_ADDR_TX) {
+        copy(want->tx_addr, txn->regs.tx_addr, 5);
+    }
+}
+
+/**
+ * @brief Commit a configuration transaction.
+ *
+ * Only the staged fields are applied, onto the cached image as it is at
+ * commit time, and only the registers that then differ are written, in one
+ * batch. The radio (CE) is turned off just around that batch, and not at all
+ * if nothing changed.
+ *
+ * @param nrf24  Pointer to the NRF24 device instance.
+ * @param txn    Transaction started by `nrf24_cfg_begin()`.
+ * @return       0 on success, non-zero on error.
+ */
+int nrf24_cfg_commit(nrf24_t *nrf24, const nrf24_cfg_txn_t *txn)
+{
+    int ret = 0;
+    uint8_t is_radio_on;
+    nrf24_regfile_t want;
+
+    LOCK(nrf24);
+
+    if (!nrf24->is_shadow_valid) {
+        ret = nrf24_cfg_resync(nrf24);
+    }
+    if (ret != 0) {
+        UNLOCK(nrf24);
+        return ret;
+    }
+
+    txn_merge(txn, &nrf24->shadow, &want);
+    if (regfile_diff(&nrf24->shadow, &want) == 0) {
+        UNLOCK(nrf24);
+        return 0;
+    }
+
+    is_radio_on = nrf24->is_radio_on;
+    if (is_radio_on) {
+        nrf24_radio_off(nrf24);
+    }
+
+    ret = regfile_write_diff(&nrf24->dep, &nrf24->shadow, &want, 0);
+
+    if (is_radio_on) {
+        nrf24_radio_on(nrf24);
+    }
+
+    if (ret == 0) {
+        copy(&nrf24->shadow, &want, sizeof(want));
+    } else {
+        /* partially written, re-read on next use */
+        nrf24->is_shadow_valid = 0;
+    }
+
+    UNLOCK(nrf24);
+
+    return ret;
+}
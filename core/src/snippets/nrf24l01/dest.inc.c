@@ -0,0 +1,99 @@
+
+/**
+ * @brief Configured address width in bytes (3-5).
+ *
+ * @note No I/O if the register shadow is valid.
+ */
+uint8_t nrf24_addr_width(nrf24_t *nrf24)
+{
+    uint8_t setupaw;
+
+    if (nrf24->is_shadow_valid) {
+        return regfile_aw(&nrf24->shadow);
+    }
+
+    if (read_reg(&nrf24->dep, NRF24_REG_SETUP_AW, &setupaw) != 0) {
+        return 5;
+    }
+
+    return aw_bytes(setupaw);
+}
+
+/**
+ * @brief Set the transmit destination (PTX).
+ *
+ * Rewrites TX_ADDR and RX_ADDR_P0 (for auto-ack) only when the destination
+ * actually changes; selecting the current destination costs no I/O.
+ *
+ * Packets already in the TX FIFO go to whatever TX_ADDR holds when they are
+ * transmitted, so the switch is refused until the TX FIFO is drained.
+ *
+ * @param nrf24  Pointer to the NRF24 device instance.
+ * @param addr   Address (LSB first), `nrf24_addr_width()` bytes.
+ * @return 0 on success, `NRF24_ERR_BUSY` if the TX FIFO is not empty, other non-zero on error.
+ *
+ * @note The destination is cached in the register shadow; if the shadow is not
+ *       valid (e.g. after `nrf24_setup_full()`) both registers are always written.
+ */
+int nrf24_dest_set(nrf24_t *nrf24, const uint8_t *addr)
+{
+    int ret = 0;
+    uint8_t aw;
+
+    LOCK(nrf24);
+
+    aw = nrf24_addr_width(nrf24);
+    if (nrf24->is_shadow_valid && compare(nrf24->shadow.tx_addr, addr, aw) == 0
+        && compare(nrf24->shadow.rx_addr_p0, addr, aw) == 0) {
+        goto __exit;
+    }
+
+    if (!nrf24_txfifo_is_empty(nrf24)) {
+        ret = NRF24_ERR_BUSY;
+        goto __exit;
+    }
+
+    ret += write_regs(&nrf24->dep, NRF24_REG_TX_ADDR, addr, aw);
+    ret += write_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, addr, aw);
+
+    if (nrf24->is_shadow_valid) {
+        if (ret == 0) {
+            copy(nrf24->shadow.tx_addr, addr, aw);
+            copy(nrf24->shadow.rx_addr_p0, addr, aw);
+        } else {
+            nrf24->is_shadow_valid = 0;
+        }
+    }
+
+__exit:
+    UNLOCK(nrf24);
+    return ret;
+}
+
+/**
+ * @brief Get the current transmit destination.
+ *
+ * @param[out] addr  Buffer of `nrf24_addr_width()` bytes.
+ * @return 0 on success.
+ */
+int nrf24_dest_get(nrf24_t *nrf24, uint8_t *addr)
+{
+    uint8_t aw = nrf24_addr_width(nrf24);
+
+    if (nrf24->is_shadow_valid) {
+        copy(addr, nrf24->shadow.tx_addr, aw);
+        return 0;
+    }
+
+    return read_regs(&nrf24->dep, NRF24_REG_TX_ADDR, addr, aw);
+}
+
+/**
+ * @brief Check whether `addr` is the current (cached) destination.
+ *
+ * @return `true` if known to be current (no I/O), `false` otherwise.
+ */
+int nrf24_dest_is_current(nrf24_t *nrf24, const uint8_t *addr)
+{
+    return nrf24->is_shadow_valid && compare(nrf24->shadow.tx_addr, addr, regfile_aw(&nrf24->shadow)) == 0;
+}
@@ -128,6 +128,20 @@ int nrf24_txfifo_ptx_write_no_ack(nrf24_t *nrf24, const uint8_t *data, uint8_t l
     return send_cmd_write_tx_payload_no_ack(&nrf24->dep, data, len);
 }
 
+/**
+ * @brief Reuse the current TX payload (PTX mode only).
+ *
+ * The payload at the head of the TX FIFO is sent again on every CE pulse
+ * (or continuously while CE is high) without rewriting it over SPI.
+ *
+ * @note Stays active until the TX FIFO is written or flushed.
+ * @attention Must not be issued while a packet is being transmitted.
+ */
+int nrf24_txfifo_reuse(nrf24_t *nrf24)
+{
+    return send_cmd_reuse_tx_payload(&nrf24->dep);
+}
+
 /**
  * @brief Flush (clear) the TX FIFO.
  *
@@ -184,8 +198,11 @@ int nrf24_rxfifo_read(nrf24_t *nrf24, uint8_t *buf, uint8_t *data_len, uint8_t *
 {
     uint8_t sta;
 
+    LOCK(nrf24);
+
     *data_len = send_cmd_read_rx_payload_width(&nrf24->dep);
     if (*data_len == 0) {
+        UNLOCK(nrf24);
         LOG_D("No data in RX FIFO");
         return -1;
     }
@@ -196,7 +213,9 @@ int nrf24_rxfifo_read(nrf24_t *nrf24, uint8_t *buf, uint8_t *data_len, uint8_t *
     }
 
     send_cmd_read_rx_payload(&nrf24->dep, buf, *data_len);
-    
+
+    UNLOCK(nrf24);
+
     return 0;
 }
 
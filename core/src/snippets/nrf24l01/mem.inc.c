@@ -27,5 +27,5 @@ static int compare(const void *x, const void *y, int size_in_byte)
         }
     }
 
-    return 0;
+    return ret;
 }
\ No newline at end of file
@@ -0,0 +1,183 @@
+
+/**
+ * @brief Derive the power state from PWR_UP, CE and the role.
+ *
+ * Keeps the current label when TX and Standby-II cannot be told apart
+ * (they differ only in TX FIFO contents).
+ */
+static nrf24_pwr_state_t pwr_derive(nrf24_t *nrf24)
+{
+    if (!nrf24->pwr.is_pwr_up) {
+        return NRF24_PWR_DOWN;
+    }
+    if (!nrf24->is_radio_on) {
+        return NRF24_PWR_STANDBY_I;
+    }
+    if (nrf24->role == NRF24_ROLE_PRX) {
+        return NRF24_PWR_RX;
+    }
+
+    return nrf24->pwr.state == NRF24_PWR_TX ? NRF24_PWR_TX : NRF24_PWR_STANDBY_II;
+}
+
+/**
+ * @brief Follow changes made by the bit-level functions (`nrf24_power_up()`, `nrf24_radio_on()`, ...).
+ *
+ * @note No timestamp is known there, so timing and residency only cover `nrf24_pwr_request()`.
+ */
+static void pwr_sync(nrf24_t *nrf24)
+{
+    nrf24->pwr.state = pwr_derive(nrf24);
+}
+
+static int pwr_is_active(nrf24_pwr_state_t state)
+{
+    return state == NRF24_PWR_RX || state == NRF24_PWR_TX || state == NRF24_PWR_STANDBY_II;
+}
+
+/**
+ * @brief Move to `target`, optionally queueing a PTX payload while CE is low.
+ */
+static int pwr_transition(nrf24_t *nrf24, nrf24_pwr_state_t target, const uint8_t *data, uint8_t len, uint32_t now_us)
+{
+    int ret = 0;
+    nrf24_pwr_t *pwr = &nrf24->pwr;
+    nrf24_pwr_state_t cur;
+    uint32_t delay = 0;
+
+    LOCK(nrf24);
+
+    cur = pwr_derive(nrf24);
+    if (target == cur || (pwr_is_active(target) && pwr_is_active(cur)
+        && target != NRF24_PWR_RX && cur != NRF24_PWR_RX)) {
+        if (data) {
+            ret = send_cmd_write_tx_payload(&nrf24->dep, data, len);
+        }
+        pwr->state = target;
+        pwr->skipped++;
+        goto __exit;
+    }
+
+    pwr->residency_us[cur] += now_us - pwr->since_us;
+    pwr->since_us = now_us;
+    pwr->transitions++;
+
+    if (!pwr_is_active(target)) {
+        nrf24_radio_off(nrf24);
+        ret = shadow_modify_bits(nrf24, NRF24_REG_CONFIG, REG_CONFIG_BITMASK_PWR_UP, target != NRF24_PWR_DOWN);
+        if (cur == NRF24_PWR_DOWN && target == NRF24_PWR_STANDBY_I) {
+            delay = NRF24_TPD2STBY_US;
+        }
+    }else {
+        nrf24_role_enum_t role = target == NRF24_PWR_RX ? NRF24_ROLE_PRX : NRF24_ROLE_PTX;
+
+        if (nrf24->is_radio_on) {
+            nrf24_radio_off(nrf24); // role change, must pass Standby-I
+        }
+        nrf24->role = role;
+        ret = shadow_modify_bits(nrf24, NRF24_REG_CONFIG, REG_CONFIG_BITMASK_PWR_UP | REG_CONFIG_BITMASK_PRIM_RX,
+            REG_CONFIG_BITMASK_PWR_UP | (role == NRF24_ROLE_PRX ? REG_CONFIG_BITMASK_PRIM_RX : 0));
+        if (data) {
+            ret += send_cmd_write_tx_payload(&nrf24->dep, data, len);
+        }
+        nrf24_radio_on(nrf24);
+        delay = (cur == NRF24_PWR_DOWN ? NRF24_TPD2STBY_US : 0) + NRF24_TSTBY2A_US;
+    }
+
+    pwr->is_pwr_up = target != NRF24_PWR_DOWN;
+    pwr->state = target;
+    pwr->ready_us = now_us + delay;
+
+__exit:
+    UNLOCK(nrf24);
+
+    return ret;
+}
+
+/**
+ * @brief Request a power state.
+ *
+ * Does only the I/O the transition needs (none if already there) and never
+ * sleeps; the state is usable from `nrf24_pwr_ready_at()` on.
+ *
+ * - DOWN:        CE low, PWR_UP=0.
+ * - STANDBY_I:   CE low, PWR_UP=1 (Tpd2stby from DOWN).
+ * - RX:          PRX, PWR_UP=1, CE high (+Tstby2a).
+ * - TX/STANDBY_II: PTX, PWR_UP=1, CE high (+Tstby2a); the chip sends while the
+ *                TX FIFO has data and idles in Standby-II otherwise, so
+ *                switching between these two needs no I/O.
+ *
+ * Switching between RX and TX goes through Standby-I (CE low) and keeps the FIFOs.
+ *
+ * @param target  Requested state.
+ * @param now_us  Current time (us), any free-running counter.
+ * @return 0 on success, non-zero on error.
+ */
+int nrf24_pwr_request(nrf24_t *nrf24, nrf24_pwr_state_t target, uint32_t now_us)
+{
+    CHECK(target < NRF24_PWR_STATE_NUM);
+
+    return pwr_transition(nrf24, target, 0, 0, now_us);
+}
+
+/**
+ * @brief Fast role turnaround for request/response protocols.
+ *
+ * CE low, one CONFIG write (PRIM_RX, nothing if the role is already set),
+ * CE high. Unlike `nrf24_role_switch()` the FIFOs and status flags are kept
+ * and there is no read-modify-write. The new role is usable from
+ * `nrf24_pwr_ready_at()` (Tstby2a after `now_us`).
+ *
+ * @param role    New role.
+ * @param data    PTX only, optional: payload queued while CE is low, so it goes out as soon as TX settles.
+ * @param len     Payload length.
+ * @param now_us  Current time (us).
+ * @return 0 on success, non-zero on error.
+ *
+ * @note Needs the shadow (after setup) for the single-write path.
+ */
+int nrf24_turnaround(nrf24_t *nrf24, nrf24_role_enum_t role, const uint8_t *data, uint8_t len, uint32_t now_us)
+{
+    CHECK(data == 0 || (role == NRF24_ROLE_PTX && len > 0 && len <= 32));
+
+    return pwr_transition(nrf24, role == NRF24_ROLE_PRX ? NRF24_PWR_RX : NRF24_PWR_TX, data, len, now_us);
+}
+
+/// @return Current power state
+nrf24_pwr_state_t nrf24_pwr_state(nrf24_t *nrf24)
+{
+    return nrf24->pwr.state;
+}
+
+/// @return Earliest time (us) the current state is usable
+uint32_t nrf24_pwr_ready_at(nrf24_t *nrf24)
+{
+    return nrf24->pwr.ready_us;
+}
+
+/// @return `true` if the current state has settled at `now_us`
+int nrf24_pwr_is_ready(nrf24_t *nrf24, uint32_t now_us)
+{
+    return (int32_t)(now_us - nrf24->pwr.ready_us) >= 0;
+}
+
+/**
+ * @brief Time spent in a state, including the ongoing stay.
+ *
+ * @return Residency in us (wraps after ~71 minutes).
+ */
+uint32_t nrf24_pwr_residency(nrf24_t *nrf24, nrf24_pwr_state_t state, uint32_t now_us)
+{
+    uint32_t t;
+
+    if (state >= NRF24_PWR_STATE_NUM) {
+        return 0;
+    }
+
+    t = nrf24->pwr.residency_us[state];
+    if (state == nrf24->pwr.state) {
+        t += now_us - nrf24->pwr.since_us;
+    }
+
+    return t;
+}
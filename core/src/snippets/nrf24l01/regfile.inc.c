@@ -0,0 +1,241 @@
+
+/* Single-byte configuration registers mirrored by `nrf24_regfile_t` */
+static const uint8_t g_regfile_regs[] = {
+    NRF24_REG_CONFIG,
+    NRF24_REG_EN_AA,
+    NRF24_REG_EN_RXADDR,
+    NRF24_REG_SETUP_AW,
+    NRF24_REG_SETUP_RETR,
+    NRF24_REG_RF_CH,
+    NRF24_REG_RF_SETUP,
+    NRF24_REG_RX_ADDR_P2,
+    NRF24_REG_RX_ADDR_P3,
+    NRF24_REG_RX_ADDR_P4,
+    NRF24_REG_RX_ADDR_P5,
+    NRF24_REG_DYNPD,
+    NRF24_REG_FEATURE,
+};
+
+#define REGFILE_REGS_NUM ((int)(sizeof(g_regfile_regs) / sizeof(g_regfile_regs[0])))
+
+#define CONFIG_BITMASK_CRC (REG_CONFIG_BITMASK_EN_CRC | REG_CONFIG_BITMASK_CRCO)
+
+/**
+ * @brief Address width in bytes from a SETUP_AW value (the illegal 0 counts as 5).
+ */
+static uint8_t aw_bytes(uint8_t setup_aw)
+{
+    setup_aw &= REG_AW_BITMASK_AW;
+    return setup_aw ? setup_aw + 2 : 5;
+}
+
+/**
+ * @brief SETUP_AW value of a user config address width (0 counts as 5 bytes).
+ */
+static uint8_t aw_setup(nrf24_aw_enum_t aw)
+{
+    return aw_bytes(aw) - 2;
+}
+
+/**
+ * @brief CONFIG EN_CRC/CRCO bits (`CONFIG_BITMASK_CRC` field) of a user config CRC length.
+ */
+static uint8_t crc_bits(nrf24_crc_enum_t crc)
+{
+    switch (crc) {
+    case NRF24_CRC_OFF: return 0x0;
+    case NRF24_CRC_1BYTE: return 0x2;
+    default: return 0x3;
+    }
+}
+
+static nrf24_crc_enum_t crc_from_bits(uint8_t bits)
+{
+    switch (bits) {
+    case 0x2: return NRF24_CRC_1BYTE;
+    case 0x3: return NRF24_CRC_2BYTES;
+    default: return NRF24_CRC_OFF;
+    }
+}
+
+static uint8_t regfile_aw(const nrf24_regfile_t *rf)
+{
+    return aw_bytes(rf->regs[NRF24_REG_SETUP_AW]);
+}
+
+/**
+ * @brief Fill the single-byte registers of a register file from a register image.
+ */
+static void regfile_load_image(nrf24_regfile_t *rf, const uint8_t *image)
+{
+    while (image[0] != NRF24_REGIMAGE_END) {
+        uint8_t reg = image[0];
+        uint8_t num = image[1];
+
+        for (uint8_t i = 0; i < num && reg + i < NRF24_REGFILE_SIZE; i++) {
+            rf->regs[reg + i] = image[2 + i];
+        }
+
+        image += 2 + num;
+    }
+}
+
+/**
+ * @brief Apply a user config to a register file (no I/O).
+ *
+ * Mirrors what `nrf24_usercfg_write_directly()` writes to the device.
+ */
+static void regfile_apply_usercfg(nrf24_regfile_t *rf, const nrf24_user_cfg_t *ucfg)
+{
+    uint8_t enrx = 0;
+    uint8_t enaa = 0;
+
+    byte_set_bits(&rf->regs[NRF24_REG_RF_SETUP], REG_RF_SETUP_BITMASK_RF_DR, ucfg->rf_adr);
+    byte_set_bits(&rf->regs[NRF24_REG_RF_SETUP], REG_RF_SETUP_BITMASK_RF_PWR, ucfg->rf_power);
+
+    rf->regs[NRF24_REG_RF_CH] = 0;
+    byte_set_bits(&rf->regs[NRF24_REG_RF_CH], REG_RF_CH_BITMASK_RF_CH, ucfg->rf_channel);
+
+    for (int i = 0; i < 6; i++) {
+        byte_set_bits(&enrx, (BITMASK_PIPE_0 << i), ucfg->rxpipes[i].enable ? 1 : 0);
+        byte_set_bits(&enaa, (BITMASK_PIPE_0 << i), ucfg->rxpipes[i].enable_aa ? 1 : 0);
+    }
+    rf->regs[NRF24_REG_EN_RXADDR] = enrx;
+    rf->regs[NRF24_REG_EN_AA] = enaa;
+
+    byte_set_bits(&rf->regs[NRF24_REG_SETUP_AW], REG_AW_BITMASK_AW, aw_setup(ucfg->addr_width));
+    byte_set_bits(&rf->regs[NRF24_REG_CONFIG], CONFIG_BITMASK_CRC, crc_bits(ucfg->crc));
+
+    copy(rf->tx_addr, ucfg->tx_addr, 5);
+    copy(rf->rx_addr_p0, ucfg->rxpipes[0].addr, 5);
+    copy(rf->rx_addr_p1, ucfg->rxpipes[1].addr, 5);
+    for (int i = 2; i < 6; i++) {
+        rf->regs[NRF24_REG_RX_ADDR_P0 + i] = ucfg->rxpipes[i].addr_lsb;
+    }
+}
+
+/**
+ * @brief Read the mirrored registers from the device.
+ *
+ * @note The device does not auto-increment register addresses, so single-byte
+ *       registers take one transaction each; addresses are read in one burst each.
+ */
+static int regfile_read(nrf24_dep_t *dep, nrf24_regfile_t *rf)
+{
+    int ret = 0;
+    uint8_t aw;
+
+    for (int i = 0; i < REGFILE_REGS_NUM; i++) {
+        ret += read_reg(dep, g_regfile_regs[i], &rf->regs[g_regfile_regs[i]]);
+    }
+
+    aw = regfile_aw(rf);
+    ret += read_regs(dep, NRF24_REG_RX_ADDR_P0, rf->rx_addr_p0, aw);
+    ret += read_regs(dep, NRF24_REG_RX_ADDR_P1, rf->rx_addr_p1, aw);
+    ret += read_regs(dep, NRF24_REG_TX_ADDR, rf->tx_addr, aw);
+
+    return ret;
+}
+
+/**
+ * @brief Count the mirrored registers which differ between two register files.
+ */
+static int regfile_diff(const nrf24_regfile_t *a, const nrf24_regfile_t *b)
+{
+    int cnt = 0;
+    uint8_t aw = regfile_aw(b);
+
+    for (int i = 0; i < REGFILE_REGS_NUM; i++) {
+        if (a->regs[g_regfile_regs[i]] != b->regs[g_regfile_regs[i]]) {
+            cnt++;
+        }
+    }
+
+    cnt += compare(a->rx_addr_p0, b->rx_addr_p0, aw) != 0;
+    cnt += compare(a->rx_addr_p1, b->rx_addr_p1, aw) != 0;
+    cnt += compare(a->tx_addr, b->tx_addr, aw) != 0;
+
+    return cnt;
+}
+
+/**
+ * @brief Whether `cur` (read back) is a device already set up like `want`,
+ * so that writing the difference is enough.
+ *
+ * CONFIG is compared without the role and power bits, which a warm restart
+ * may legitimately change.
+ */
+static int regfile_is_warm(const nrf24_regfile_t *cur, const nrf24_regfile_t *want)
+{
+    static const uint8_t regs[] = {
+        NRF24_REG_RF_CH,
+        NRF24_REG_RF_SETUP,
+        NRF24_REG_SETUP_AW,
+        NRF24_REG_FEATURE,
+    };
+    uint8_t mask = (uint8_t)~(REG_CONFIG_BITMASK_PRIM_RX | REG_CONFIG_BITMASK_PWR_UP);
+
+    if ((cur->regs[NRF24_REG_CONFIG] & mask) != (want->regs[NRF24_REG_CONFIG] & mask)) {
+        return 0;
+    }
+    for (int i = 0; i < (int)sizeof(regs); i++) {
+        if (cur->regs[regs[i]] != want->regs[regs[i]]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Write only the registers of `want` which differ from `cur`.
+ *
+ * @param[out] nwritten  Number of registers written (optional).
+ * @return               0 on success, non-zero on error.
+ *
+ * @note SETUP_AW is written first (the addresses follow its width) and
+ *       CONFIG last, so power/role changes happen after everything else is in place.
+ */
+static int regfile_write_diff(nrf24_dep_t *dep, const nrf24_regfile_t *cur, const nrf24_regfile_t *want, int *nwritten)
+{
+    int ret = 0;
+    int cnt = 0;
+    uint8_t aw = regfile_aw(want);
+    uint8_t aw_changed = cur->regs[NRF24_REG_SETUP_AW] != want->regs[NRF24_REG_SETUP_AW];
+
+    if (aw_changed) {
+        ret += write_reg(dep, NRF24_REG_SETUP_AW, want->regs[NRF24_REG_SETUP_AW]);
+        cnt++;
+    }
+
+    if (aw_changed || compare(cur->rx_addr_p0, want->rx_addr_p0, aw) != 0) {
+        ret += write_regs(dep, NRF24_REG_RX_ADDR_P0, want->rx_addr_p0, aw);
+        cnt++;
+    }
+    if (aw_changed || compare(cur->rx_addr_p1, want->rx_addr_p1, aw) != 0) {
+        ret += write_regs(dep, NRF24_REG_RX_ADDR_P1, want->rx_addr_p1, aw);
+        cnt++;
+    }
+    if (aw_changed || compare(cur->tx_addr, want->tx_addr, aw) != 0) {
+        ret += write_regs(dep, NRF24_REG_TX_ADDR, want->tx_addr, aw);
+        cnt++;
+    }
+
+    /* reverse order: CONFIG (the first entry) goes last */
+    for (int i = REGFILE_REGS_NUM - 1; i >= 0; i--) {
+        uint8_t reg = g_regfile_regs[i];
+        if (reg == NRF24_REG_SETUP_AW) {
+            continue;
+        }
+        if (cur->regs[reg] != want->regs[reg]) {
+            ret += write_reg(dep, reg, want->regs[reg]);
+            cnt++;
+        }
+    }
+
+    if (nwritten != 0) {
+        *nwritten = cnt;
+    }
+
+    return ret;
+}
@@ -0,0 +1,70 @@
+#ifdef NRF24L01_ENABLE_TIMESTAMP
+
+#ifndef NRF24L01_TIMESTAMP_US
+#error "Missing NRF24L01_TIMESTAMP_US definition (a free-running us counter)"
+#endif
+
+/**
+ * @brief Stamp a pending event; call first thing in the IRQ handler.
+ *
+ * The time is attached to the events seen by the next STATUS read instead of
+ * the (later, jittery) read time. ISR-safe, no I/O.
+ */
+void nrf24_irq_stamp(nrf24_t *nrf24)
+{
+    nrf24->ts.irq_us = NRF24L01_TIMESTAMP_US();
+    nrf24->ts.is_irq_stamped = 1;
+}
+
+/// Stamp the events first seen in `sta`
+static void ts_capture(nrf24_t *nrf24, uint8_t sta)
+{
+    uint8_t fresh = sta & ~nrf24->ts.stamped & (REG_STATUS_BITMASK_RX_DR | REG_STATUS_BITMASK_TX_DS | REG_STATUS_BITMASK_MAX_RT);
+    uint32_t t;
+
+    if (fresh == 0) {
+        return;
+    }
+
+    if (nrf24->ts.is_irq_stamped) {
+        t = nrf24->ts.irq_us;
+        nrf24->ts.is_irq_stamped = 0;
+    }else {
+        t = NRF24L01_TIMESTAMP_US();
+    }
+
+    if (fresh & REG_STATUS_BITMASK_RX_DR) {
+        nrf24->ts.rx_us = t;
+    }
+    if (fresh & (REG_STATUS_BITMASK_TX_DS | REG_STATUS_BITMASK_MAX_RT)) {
+        nrf24->ts.tx_us = t;
+    }
+    nrf24->ts.stamped |= fresh;
+}
+
+/// Flags cleared in the chip, their next occurrence is a new event
+static void ts_release(nrf24_t *nrf24, uint8_t sta)
+{
+    nrf24->ts.stamped &= ~sta;
+}
+
+/**
+ * @brief Time (us) of the RX_DR event the packets in the RX FIFO arrived with.
+ *
+ * @note Packets that arrive under one RX_DR (before it is cleared) share its time.
+ */
+uint32_t nrf24_rx_timestamp(nrf24_t *nrf24)
+{
+    return nrf24->ts.rx_us;
+}
+
+/// @return Time (us) of the last TX completion (TX_DS or MAX_RT)
+uint32_t nrf24_tx_timestamp(nrf24_t *nrf24)
+{
+    return nrf24->ts.tx_us;
+}
+
+#else
+#define ts_capture(nrf24, sta)
+#define ts_release(nrf24, sta)
+#endif // NRF24L01_ENABLE_TIMESTAMP
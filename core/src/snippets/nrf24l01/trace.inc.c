@@ -0,0 +1,84 @@
+#ifdef NRF24L01_ENABLE_TRACE
+
+#ifndef NRF24L01_TRACE_TIMESTAMP_HZ
+#define NRF24L01_TRACE_TIMESTAMP_HZ 1000000
+#endif
+
+/**
+ * @brief Start recording SPI transactions of the instance into a ring buffer.
+ *
+ * @param nrf24  Pointer to the NRF24 device instance.
+ * @param trace  Trace control block (owned by the caller).
+ * @param recs   Record storage.
+ * @param num    Number of records in `recs`, must be a power of two.
+ * @return       0 on success, negative on invalid arguments.
+ *
+ * @note Once full, the oldest records are overwritten.
+ */
+int nrf24_trace_attach(nrf24_t *nrf24, nrf24_trace_t *trace, nrf24_trace_rec_t *recs, uint32_t num)
+{
+    CHECK(nrf24 != 0 && trace != 0 && recs != 0);
+    CHECK(num != 0 && (num & (num - 1)) == 0);
+
+    trace->recs = recs;
+    trace->mask = num - 1;
+    trace->seq = 0;
+    trace->status = NRF24_TRACE_STATUS_UNKNOWN;
+
+    nrf24->dep.trace = trace;
+    return 0;
+}
+
+/**
+ * @brief Stop recording. The recorded data stays in the trace buffer.
+ */
+void nrf24_trace_detach(nrf24_t *nrf24)
+{
+    nrf24->dep.trace = 0;
+}
+
+/**
+ * @brief Copy the recorded transactions out in dump format (oldest first).
+ *
+ * @param trace  Trace control block.
+ * @param hdr    Output dump header.
+ * @param out    Output records, may be NULL to query the count only.
+ * @param max    Capacity of `out` (newest records are kept when smaller than the recorded count).
+ * @return       Number of records copied (or available, when `out` is NULL).
+ *
+ * @note Call it while the trace is detached (or the instance is idle) to get a consistent snapshot.
+ */
+int nrf24_trace_snapshot(const nrf24_trace_t *trace, nrf24_trace_hdr_t *hdr, nrf24_trace_rec_t *out, int max)
+{
+    uint32_t cap = trace->mask + 1;
+    uint32_t avail = trace->seq < cap ? trace->seq : cap;
+    uint32_t count = avail;
+    uint32_t start;
+
+    if (out != 0 && (uint32_t)max < count) {
+        count = (uint32_t)max;
+    }
+    start = trace->seq - count;
+
+    if (hdr != 0) {
+        hdr->magic[0] = NRF24_TRACE_MAGIC0;
+        hdr->magic[1] = NRF24_TRACE_MAGIC1;
+        hdr->version = NRF24_TRACE_VERSION;
+        hdr->rec_size = sizeof(nrf24_trace_rec_t);
+        hdr->ts_hz = NRF24L01_TRACE_TIMESTAMP_HZ;
+        hdr->count = count;
+        hdr->lost = trace->seq - count;
+    }
+
+    if (out == 0) {
+        return (int)avail;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = trace->recs[(start + i) & trace->mask];
+    }
+
+    return (int)count;
+}
+
+#endif // NRF24L01_ENABLE_TRACE
@@ -11,6 +11,8 @@ void nrf24_usercfg_init_default(nrf24_user_cfg_t *ucfg)
     ucfg->rf_channel = 2;
     ucfg->rf_power = NRF24_RF_POWER_0dBm;
     ucfg->rf_adr = NRF24_ADR_2Mbps;
+    ucfg->addr_width = NRF24_AW_5BYTES;
+    ucfg->crc = NRF24_CRC_2BYTES;
 
     /*  */
     ucfg->rxpipes[0].enable = 1;
@@ -53,7 +55,14 @@ int nrf24_usercfg_read(nrf24_t *nrf24, nrf24_user_cfg_t *ucfg)
     uint8_t enaa;
     uint8_t rfch;
     uint8_t rfsetup;
+    uint8_t setupaw;
+    uint8_t config;
+    uint8_t aw;
 
+    LOCK(nrf24);
+
+    ret += read_reg(&nrf24->dep, NRF24_REG_SETUP_AW, &setupaw);
+    ret += read_reg(&nrf24->dep, NRF24_REG_CONFIG, &config);
     ret += read_reg(&nrf24->dep, NRF24_REG_EN_RXADDR, &enrx);
     ret += read_reg(&nrf24->dep, NRF24_REG_EN_AA, &enaa);
     ret += read_reg(&nrf24->dep, NRF24_REG_RF_CH, &rfch);
@@ -62,49 +71,58 @@ int nrf24_usercfg_read(nrf24_t *nrf24, nrf24_user_cfg_t *ucfg)
     ucfg->rf_adr = byte_get_bits(rfsetup, REG_RF_SETUP_BITMASK_RF_DR);
     ucfg->rf_power = byte_get_bits(rfsetup, REG_RF_SETUP_BITMASK_RF_PWR);
     ucfg->rf_channel = byte_get_bits(rfch, REG_RF_CH_BITMASK_RF_CH);
+    aw = aw_bytes(setupaw);
+    ucfg->addr_width = (nrf24_aw_enum_t)(aw - 2);
+    ucfg->crc = crc_from_bits(byte_get_bits(config, CONFIG_BITMASK_CRC));
 
     for (int i = 0; i < 6; i++) {
         ucfg->rxpipes[i].enable = enrx & (BITMASK_PIPE_0 << i) ? 1 : 0;
         ucfg->rxpipes[i].enable_aa = enaa & (BITMASK_PIPE_0 << i) ? 1 : 0;
     }
 
-    ret += read_regs(&nrf24->dep, NRF24_REG_TX_ADDR, ASU8P(&ucfg->tx_addr[0]), 5);    
-    ret += read_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, ASU8P(&ucfg->rxpipes[0].addr[0]), 5);
-    ret += read_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P1, ASU8P(&ucfg->rxpipes[1].addr[0]), 5);
+    clear_object(ucfg->tx_addr, 5);
+    clear_object(ucfg->rxpipes[0].addr, 5);
+    clear_object(ucfg->rxpipes[1].addr, 5);
+    ret += read_regs(&nrf24->dep, NRF24_REG_TX_ADDR, ASU8P(&ucfg->tx_addr[0]), aw);    
+    ret += read_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, ASU8P(&ucfg->rxpipes[0].addr[0]), aw);
+    ret += read_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P1, ASU8P(&ucfg->rxpipes[1].addr[0]), aw);
     ret += read_reg(&nrf24->dep, NRF24_REG_RX_ADDR_P2, ASU8P(&ucfg->rxpipes[2].addr_lsb));
     ret += read_reg(&nrf24->dep, NRF24_REG_RX_ADDR_P3, ASU8P(&ucfg->rxpipes[3].addr_lsb));
     ret += read_reg(&nrf24->dep, NRF24_REG_RX_ADDR_P4, ASU8P(&ucfg->rxpipes[4].addr_lsb));
     ret += read_reg(&nrf24->dep, NRF24_REG_RX_ADDR_P5, ASU8P(&ucfg->rxpipes[5].addr_lsb));
 
+    UNLOCK(nrf24);
+
     return ret;
 }
 
 /**
  * @brief Writes user configuration to device.
  *
+ * Only the registers that actually change are written (see `nrf24_cfg_commit()`).
+ *
  * @param nrf24  Pointer to device structure.
  * @param ucfg   Pointer to config struct.
  *
  * @return 0 on success, non-zero on error.
  * 
  * @note Involves actual I/O; avoid frequent calls.
- * @attention Temporarily disables the radio during configuration update.
+ * @attention Temporarily disables the radio during configuration update (only if something changes).
  */
 int nrf24_usercfg_write(nrf24_t *nrf24, const nrf24_user_cfg_t *ucfg)
 {
     int ret = 0;
+    nrf24_cfg_txn_t txn;
 
-    uint8_t is_radio_on = nrf24->is_radio_on;
+    LOCK(nrf24);
 
-    if (is_radio_on) {
-        nrf24_radio_off(nrf24);
+    ret = nrf24_cfg_begin(nrf24, &txn);
+    if (ret == 0) {
+        nrf24_cfg_apply_usercfg(&txn, ucfg);
+        ret = nrf24_cfg_commit(nrf24, &txn);
     }
 
-    ret = nrf24_usercfg_write_directly(nrf24, ucfg);
-
-    if (is_radio_on) {
-        nrf24_radio_on(nrf24);
-    }
+    UNLOCK(nrf24);
 
     return ret;
 }
@@ -119,6 +137,18 @@ int nrf24_usercfg_write_directly(nrf24_t *nrf24, const nrf24_user_cfg_t *ucfg)
     uint8_t enaa = 0;
     uint8_t rfch = 0;
     uint8_t rfsetup = 0;
+    uint8_t config = 0;
+    uint8_t aw = aw_bytes(ucfg->addr_width);
+
+    LOCK(nrf24);
+
+    /* CONFIG REGISTER (crc) */
+    ret += read_reg(&nrf24->dep, NRF24_REG_CONFIG, &config);
+    byte_set_bits(&config, CONFIG_BITMASK_CRC, crc_bits(ucfg->crc));
+    ret += write_reg(&nrf24->dep, NRF24_REG_CONFIG, config);
+
+    /* SETUP_AW REGISTER (before the addresses) */
+    ret += write_reg(&nrf24->dep, NRF24_REG_SETUP_AW, aw_setup(ucfg->addr_width));
 
     /* RF-SETUP REGISTER */
     ret += read_reg(&nrf24->dep, NRF24_REG_RF_SETUP, &rfsetup);
@@ -139,14 +169,20 @@ int nrf24_usercfg_write_directly(nrf24_t *nrf24, const nrf24_user_cfg_t *ucfg)
     ret += write_reg(&nrf24->dep, NRF24_REG_EN_AA, enaa);
 
     /* ADDR REGSITERS */
-    ret += write_regs(&nrf24->dep, NRF24_REG_TX_ADDR, ASU8P(&ucfg->tx_addr[0]), 5);    
-    ret += write_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, ASU8P(&ucfg->rxpipes[0].addr[0]), 5);
-    ret += write_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P1, ASU8P(&ucfg->rxpipes[1].addr[0]), 5);
+    ret += write_regs(&nrf24->dep, NRF24_REG_TX_ADDR, ASU8P(&ucfg->tx_addr[0]), aw);    
+    ret += write_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, ASU8P(&ucfg->rxpipes[0].addr[0]), aw);
+    ret += write_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P1, ASU8P(&ucfg->rxpipes[1].addr[0]), aw);
     ret += write_reg(&nrf24->dep, NRF24_REG_RX_ADDR_P2, ucfg->rxpipes[2].addr_lsb);
     ret += write_reg(&nrf24->dep, NRF24_REG_RX_ADDR_P3, ucfg->rxpipes[3].addr_lsb);
     ret += write_reg(&nrf24->dep, NRF24_REG_RX_ADDR_P4, ucfg->rxpipes[4].addr_lsb);
     ret += write_reg(&nrf24->dep, NRF24_REG_RX_ADDR_P5, ucfg->rxpipes[5].addr_lsb);
 
+    if (nrf24->is_shadow_valid) {
+        regfile_apply_usercfg(&nrf24->shadow, ucfg);
+    }
+
+    UNLOCK(nrf24);
+
     return ret;
 }
 
@@ -157,14 +193,34 @@ int nrf24_usercfg_write_diff_directly(nrf24_t *nrf24, const nrf24_user_cfg_t *ol
     uint8_t enaa = 0;
     uint8_t rfch = 0;
     uint8_t rfsetup = 0;
+    uint8_t config = 0;
     const nrf24_user_cfg_t *ucfg = new;
+    uint8_t aw;
+    uint8_t aw_changed;
 
     if (old == 0) {
         return nrf24_usercfg_write_directly(nrf24, new);
     }
 
+    aw = aw_bytes(new->addr_width);
+    aw_changed = aw != aw_bytes(old->addr_width);
+
+    LOCK(nrf24);
+
+    /* CONFIG REGISTER (crc) */
+    if (crc_bits(old->crc) != crc_bits(new->crc)) {
+        ret += read_reg(&nrf24->dep, NRF24_REG_CONFIG, &config);
+        byte_set_bits(&config, CONFIG_BITMASK_CRC, crc_bits(ucfg->crc));
+        ret += write_reg(&nrf24->dep, NRF24_REG_CONFIG, config);
+    }
+
+    /* SETUP_AW REGISTER */
+    if (aw_changed) {
+        ret += write_reg(&nrf24->dep, NRF24_REG_SETUP_AW, aw_setup(new->addr_width));
+    }
+
     /* RF-SETUP REGISTER */
-    if (old->rf_adr != new->rf_adr) {
+    if (old->rf_adr != new->rf_adr || old->rf_power != new->rf_power) {
         ret += read_reg(&nrf24->dep, NRF24_REG_RF_SETUP, &rfsetup);
         byte_set_bits(&rfsetup, REG_RF_SETUP_BITMASK_RF_DR, ucfg->rf_adr);
         byte_set_bits(&rfsetup, REG_RF_SETUP_BITMASK_RF_PWR, ucfg->rf_power);
@@ -200,21 +256,27 @@ int nrf24_usercfg_write_diff_directly(nrf24_t *nrf24, const nrf24_user_cfg_t *ol
     }
 
     /* ADDR REGSITERS */
-    if (compare(&old->tx_addr[0], &new->tx_addr[0], 5) != 0) {
-        ret += write_regs(&nrf24->dep, NRF24_REG_TX_ADDR, ASU8P(&ucfg->tx_addr[0]), 5);    
+    if (aw_changed || compare(&old->tx_addr[0], &new->tx_addr[0], aw) != 0) {
+        ret += write_regs(&nrf24->dep, NRF24_REG_TX_ADDR, ASU8P(&ucfg->tx_addr[0]), aw);    
     }
-    if (compare(&old->rxpipes[0].addr[0], &new->rxpipes[0].addr[0], 5) != 0) {
-        ret += write_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, ASU8P(&ucfg->rxpipes[0].addr[0]), 5);
+    if (aw_changed || compare(&old->rxpipes[0].addr[0], &new->rxpipes[0].addr[0], aw) != 0) {
+        ret += write_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P0, ASU8P(&ucfg->rxpipes[0].addr[0]), aw);
     }
-    if (compare(&old->rxpipes[1].addr[0], &new->rxpipes[1].addr[0], 5) != 0) {
-        ret += write_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P1, ASU8P(&ucfg->rxpipes[1].addr[0]), 5);
+    if (aw_changed || compare(&old->rxpipes[1].addr[0], &new->rxpipes[1].addr[0], aw) != 0) {
+        ret += write_regs(&nrf24->dep, NRF24_REG_RX_ADDR_P1, ASU8P(&ucfg->rxpipes[1].addr[0]), aw);
     }
 
     for (int i = 2; i < 6; i++) {
-        if (old->rxpipes[i].addr[0] != new->rxpipes[i].addr[0]) {
+        if (old->rxpipes[i].addr_lsb != new->rxpipes[i].addr_lsb) {
             ret += write_reg(&nrf24->dep, NRF24_REG_RX_ADDR_P0 + i, ucfg->rxpipes[i].addr_lsb);
         }
     }
 
+    if (nrf24->is_shadow_valid) {
+        regfile_apply_usercfg(&nrf24->shadow, ucfg);
+    }
+
+    UNLOCK(nrf24);
+
     return ret;
 }
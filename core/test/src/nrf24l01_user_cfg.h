@@ -4,4 +4,7 @@
 // #define NRF24L01_LOG_SINK
 
 /* config log level */
-// #define NRF24L01_LOG_MIN_OUTPUT_LEVEL 'V'
\ No newline at end of file
+// #define NRF24L01_LOG_MIN_OUTPUT_LEVEL 'V'
+/* timestamps (host tests: a constant clock) */
+#define NRF24L01_ENABLE_TIMESTAMP
+#define NRF24L01_TIMESTAMP_US() ((uint32_t)0)
@@ -5,6 +5,13 @@
 const std = @import("std");
 const c = @cImport({
     @cInclude("nrf24l01.c");
+    @cInclude("nrf24l01_stripe.c");
+    @cInclude("nrf24l01_coalesce.c");
+    @cInclude("nrf24l01_rpc.c");
+    @cInclude("nrf24l01_bulk.c");
+    @cInclude("nrf24l01_credit.c");
+    @cInclude("nrf24l01_backoff.c");
+    @cInclude("nrf24l01_tsync.c");
 });
 
 test "c.byte_set_bits" {
@@ -104,3 +111,650 @@ test "c.byte_get_bits" {
 
     std.debug.print("c.byte_get_bits [\x1b[32mok\x1b[0m]\n", .{});
 }
+
+test "c.nrf24_reg_image_lookup" {
+    // runs: {0x00, 2 regs}, {0x1C, 1 reg}, terminator
+    const image = [_]u8{ 0x00, 2, 0x0c, 0x3f, 0x1c, 1, 0x3e, 0xff };
+    var val: u8 = 0;
+
+    // Case 1: first register of the first run
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_reg_image_lookup(&image, 0x00, &val));
+    try std.testing.expectEqual(@as(u8, 0x0c), val);
+
+    // Case 2: second register of the first run
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_reg_image_lookup(&image, 0x01, &val));
+    try std.testing.expectEqual(@as(u8, 0x3f), val);
+
+    // Case 3: register of a later run
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_reg_image_lookup(&image, 0x1c, &val));
+    try std.testing.expectEqual(@as(u8, 0x3e), val);
+
+    // Case 4: register not in the image
+    try std.testing.expectEqual(@as(c_int, -1), c.nrf24_reg_image_lookup(&image, 0x02, &val));
+
+    std.debug.print("c.nrf24_reg_image_lookup [\x1b[32mok\x1b[0m]\n", .{});
+}
+
+test "c.regfile_diff" {
+    var ucfg = std.mem.zeroes(c.nrf24_user_cfg_t);
+    var want = std.mem.zeroes(c.nrf24_regfile_t);
+    var cur: c.nrf24_regfile_t = undefined;
+
+    c.nrf24_usercfg_init_default(&ucfg);
+    c.regfile_apply_usercfg(&want, &ucfg);
+
+    // Case 1: identical files
+    cur = want;
+    try std.testing.expectEqual(@as(c_int, 0), c.regfile_diff(&cur, &want));
+    try std.testing.expectEqual(@as(c_int, 1), c.regfile_is_warm(&cur, &want));
+
+    // Case 2: zero address width / CRC mean the defaults (5 bytes, 2 bytes)
+    ucfg.addr_width = 0;
+    ucfg.crc = 0;
+    c.regfile_apply_usercfg(&cur, &ucfg);
+    try std.testing.expectEqual(@as(c_int, 0), c.regfile_diff(&cur, &want));
+    try std.testing.expectEqual(@as(u8, 3), cur.regs[c.NRF24_REG_SETUP_AW]);
+    try std.testing.expectEqual(@as(u8, 0x0c), cur.regs[c.NRF24_REG_CONFIG] & 0x0c);
+
+    // Case 3: another channel is one register and not warm
+    ucfg.rf_channel = 40;
+    c.regfile_apply_usercfg(&cur, &ucfg);
+    try std.testing.expectEqual(@as(c_int, 1), c.regfile_diff(&cur, &want));
+    try std.testing.expectEqual(@as(c_int, 0), c.regfile_is_warm(&cur, &want));
+
+    // Case 4: role and power bits differ, still warm
+    cur = want;
+    cur.regs[c.NRF24_REG_CONFIG] |= 0x03;
+    try std.testing.expectEqual(@as(c_int, 1), c.regfile_diff(&cur, &want));
+    try std.testing.expectEqual(@as(c_int, 1), c.regfile_is_warm(&cur, &want));
+
+    // Case 5: addresses are compared over the width of the second file (3 bytes)
+    cur = want;
+    cur.regs[c.NRF24_REG_SETUP_AW] = 1;
+    cur.tx_addr[4] ^= 0xff;
+    try std.testing.expectEqual(@as(c_int, 1), c.regfile_diff(&want, &cur));
+    cur.tx_addr[0] ^= 0xff;
+    try std.testing.expectEqual(@as(c_int, 2), c.regfile_diff(&want, &cur));
+
+    // Case 6: CRC off, 3 byte addresses
+    ucfg.crc = c.NRF24_CRC_OFF;
+    ucfg.addr_width = c.NRF24_AW_3BYTES;
+    c.regfile_apply_usercfg(&cur, &ucfg);
+    try std.testing.expectEqual(@as(u8, 0x00), cur.regs[c.NRF24_REG_CONFIG] & 0x0c);
+    try std.testing.expectEqual(@as(u8, 1), cur.regs[c.NRF24_REG_SETUP_AW]);
+
+    std.debug.print("c.regfile_diff [\x1b[32mok\x1b[0m]\n", .{});
+}
+
+const StripeSink = struct {
+    out: [16]u8 = undefined,
+    n: usize = 0,
+
+    fn onData(rx: [*c]c.nrf24_stripe_rx_t, data: [*c]const u8, len: u8) callconv(.c) void {
+        const self: *StripeSink = @ptrCast(@alignCast(rx.*.user_data.?));
+        _ = len;
+        self.out[self.n] = data[0];
+        self.n += 1;
+    }
+};
+
+test "c.nrf24_stripe_rx reorder" {
+    var dummy = std.mem.zeroes(c.nrf24_t);
+    var radios = [_][*c]c.nrf24_t{ &dummy, &dummy };
+    var members: [2]c.nrf24_stripe_rxm_t = undefined;
+    var rb: [4]c.nrf24_stripe_rslot_t = undefined;
+    var rx: c.nrf24_stripe_rx_t = undefined;
+    var sink = StripeSink{};
+
+    // reorder buffer size must be a power of two
+    try std.testing.expectEqual(@as(c_int, -128), c.nrf24_stripe_rx_init(&rx, &members, &radios, 2, &rb, 3));
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_stripe_rx_init(&rx, &members, &radios, 2, &rb, 4));
+    rx.on_data = &StripeSink.onData;
+    rx.user_data = &sink;
+
+    // frames: [stream seq][member seq][data]
+    const f0 = [_]u8{ 254, 0, 0xa0 };
+    const f1 = [_]u8{ 255, 0, 0xa1 };
+    const f2 = [_]u8{ 0, 1, 0xa2 };
+    const f3 = [_]u8{ 1, 1, 0xa3 };
+
+    // Case 1: stream 254, 255, 0, 1 split over two radios, reordered across the wrap
+    c.on_frame(&rx, &members[0], &f0, 3);
+    try std.testing.expectEqual(@as(usize, 1), sink.n);
+    c.on_frame(&rx, &members[0], &f2, 3);
+    try std.testing.expectEqual(@as(usize, 1), sink.n);
+    try std.testing.expectEqual(@as(u8, 1), rx.held);
+    c.on_frame(&rx, &members[1], &f1, 3);
+    c.on_frame(&rx, &members[1], &f3, 3);
+    try std.testing.expectEqualSlices(u8, &[_]u8{ 0xa0, 0xa1, 0xa2, 0xa3 }, sink.out[0..sink.n]);
+    try std.testing.expectEqual(@as(u8, 2), rx.expect);
+    try std.testing.expectEqual(@as(u8, 0), rx.held);
+    try std.testing.expectEqual(@as(u32, 0), members[0].lost);
+
+    // Case 2: a frame already delivered is late
+    c.on_frame(&rx, &members[0], &f2, 3);
+    try std.testing.expectEqual(@as(u32, 1), rx.late);
+    try std.testing.expectEqual(@as(usize, 4), sink.n);
+
+    // Case 3: 2 and 3 lost, 7 is out of the window: skip up to 4
+    const f7 = [_]u8{ 7, 2, 0xa7 };
+    const f4 = [_]u8{ 4, 2, 0xa4 };
+    c.on_frame(&rx, &members[0], &f7, 3);
+    try std.testing.expectEqual(@as(usize, 4), sink.n);
+    try std.testing.expectEqual(@as(u8, 4), rx.expect);
+    try std.testing.expectEqual(@as(u32, 2), rx.skipped);
+    c.on_frame(&rx, &members[1], &f4, 3);
+    try std.testing.expectEqual(@as(usize, 5), sink.n);
+    try std.testing.expectEqual(@as(u8, 0xa4), sink.out[4]);
+
+    std.debug.print("c.nrf24_stripe_rx reorder [\x1b[32mok\x1b[0m]\n", .{});
+}
+
+/// SPI-level stand-in for a chip: registers, 3-level TX/RX FIFOs and STATUS/FIFO_STATUS
+const Mock = struct {
+    regs: [32]u8 = [_]u8{0} ** 32,
+    tx: [3][32]u8 = undefined,
+    tx_len: [3]u8 = undefined,
+    tx_n: u8 = 0,
+    rx: [3][32]u8 = undefined,
+    rx_len: [3]u8 = undefined,
+    rx_pipe: [3]u8 = undefined,
+    rx_head: u8 = 0,
+    rx_n: u8 = 0,
+
+    var ops = c.nrf24_dep_ops_t{
+        .init = null,
+        .deinit = null,
+        .spi_send = &spiSend,
+        .spi_send_then_send = &spiSendThenSend,
+        .spi_send_then_recv = &spiSendThenRecv,
+        .set_ce_low = &setCe,
+        .set_ce_high = &setCe,
+    };
+
+    fn attach(self: *Mock, nrf24: *c.nrf24_t) !void {
+        nrf24.* = std.mem.zeroes(c.nrf24_t);
+        try std.testing.expectEqual(@as(c_int, 0), c.nrf24_init(nrf24, &ops, self));
+        nrf24.role = c.NRF24_ROLE_PTX;
+    }
+
+    fn of(ctx: ?*anyopaque) *Mock {
+        return @ptrCast(@alignCast(ctx.?));
+    }
+
+    fn status(self: *const Mock) u8 {
+        const pipe: u8 = if (self.rx_n > 0) self.rx_pipe[self.rx_head] else 7;
+        return (self.regs[0x07] & 0x70) | (pipe << 1) | @intFromBool(self.tx_n == 3);
+    }
+
+    fn fifoStatus(self: *const Mock) u8 {
+        return @as(u8, @intFromBool(self.rx_n == 0)) | (@as(u8, @intFromBool(self.rx_n == 3)) << 1) |
+            (@as(u8, @intFromBool(self.tx_n == 0)) << 4) | (@as(u8, @intFromBool(self.tx_n == 3)) << 5);
+    }
+
+    /// Queue a received payload (or ACK payload) and raise RX_DR
+    fn rxPush(self: *Mock, data: []const u8, pipe: u8) void {
+        const i = (self.rx_head + self.rx_n) % 3;
+        @memcpy(self.rx[i][0..data.len], data);
+        self.rx_len[i] = @intCast(data.len);
+        self.rx_pipe[i] = pipe;
+        self.rx_n += 1;
+        self.regs[0x07] |= 0x40;
+    }
+
+    /// Everything in the TX FIFO went out: raise TX_DS
+    fn txSent(self: *Mock) void {
+        self.tx_n = 0;
+        self.regs[0x07] |= 0x20;
+    }
+
+    fn spiSend(ctx: ?*anyopaque, buf: [*c]const u8, len: u8) callconv(.c) c_int {
+        const self = of(ctx);
+        _ = len;
+        if ((buf[0] & 0xe0) == 0x20) {
+            const reg = buf[0] & 0x1f;
+            if (reg == 0x07) {
+                self.regs[reg] &= ~(buf[1] & 0x70); // write 1 to clear
+            } else {
+                self.regs[reg] = buf[1];
+            }
+        } else if (buf[0] == 0xe1) {
+            self.tx_n = 0;
+        } else if (buf[0] == 0xe2) {
+            self.rx_n = 0;
+        }
+        return 0;
+    }
+
+    fn spiSendThenSend(ctx: ?*anyopaque, buf1: [*c]const u8, len1: u8, buf2: [*c]const u8, len2: u8) callconv(.c) c_int {
+        const self = of(ctx);
+        _ = len1;
+        const is_payload = buf1[0] == 0xa0 or buf1[0] == 0xb0 or (buf1[0] & 0xf8) == 0xa8;
+        if (is_payload and self.tx_n < 3) {
+            @memcpy(self.tx[self.tx_n][0..len2], buf2[0..len2]);
+            self.tx_len[self.tx_n] = len2;
+            self.tx_n += 1;
+        }
+        return 0;
+    }
+
+    fn spiSendThenRecv(ctx: ?*anyopaque, wbuf: [*c]const u8, wlen: u8, rbuf: [*c]u8, rlen: u8) callconv(.c) c_int {
+        const self = of(ctx);
+        _ = wlen;
+        @memset(rbuf[0..rlen], 0);
+        if (wbuf[0] < 0x20) {
+            const reg = wbuf[0] & 0x1f;
+            rbuf[0] = switch (reg) {
+                0x07 => self.status(),
+                0x17 => self.fifoStatus(),
+                else => self.regs[reg],
+            };
+        } else if (wbuf[0] == 0x60) {
+            rbuf[0] = if (self.rx_n > 0) self.rx_len[self.rx_head] else 0;
+        } else if (wbuf[0] == 0x61 and self.rx_n > 0) {
+            @memcpy(rbuf[0..rlen], self.rx[self.rx_head][0..rlen]);
+            self.rx_head = (self.rx_head + 1) % 3;
+            self.rx_n -= 1;
+        }
+        return 0;
+    }
+
+    fn setCe(ctx: ?*anyopaque) callconv(.c) void {
+        _ = ctx;
+    }
+};
+
+test "c.nrf24_coalesce" {
+    var mock = Mock{};
+    var nrf24: c.nrf24_t = undefined;
+    var co: c.nrf24_coalesce_t = undefined;
+    var it: c.nrf24_decoalesce_t = undefined;
+    var msg: [*c]const u8 = null;
+    var len: u8 = 0;
+    const a = [_]u8{ 1, 2, 3 };
+    const b = [_]u8{4};
+
+    try mock.attach(&nrf24);
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_coalesce_init(&co, &nrf24, 5));
+
+    // Case 1: messages are held until the deadline of the first one
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_coalesce_put(&co, &a, 3, 0));
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_coalesce_put(&co, &b, 1, 1));
+    try std.testing.expectEqual(@as(u8, 2), c.nrf24_coalesce_pending(&co));
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_coalesce_poll(&co, 4));
+    try std.testing.expectEqual(@as(u8, 0), mock.tx_n);
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_coalesce_poll(&co, 5));
+    try std.testing.expectEqualSlices(u8, &[_]u8{ 3, 1, 2, 3, 1, 4 }, mock.tx[0][0..mock.tx_len[0]]);
+
+    // Case 2: and split again on the receive side
+    c.nrf24_decoalesce_begin(&it, &mock.tx[0], mock.tx_len[0]);
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_decoalesce_next(&it, &msg, &len));
+    try std.testing.expectEqualSlices(u8, &a, msg[0..len]);
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_decoalesce_next(&it, &msg, &len));
+    try std.testing.expectEqualSlices(u8, &b, msg[0..len]);
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_decoalesce_next(&it, &msg, &len));
+
+    // Case 3: static payload width, frames are zero-padded
+    co.frame_size = 8;
+    co.pad = 1;
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_coalesce_put(&co, &a, 3, 10));
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_coalesce_put(&co, &b, 1, 10));
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_coalesce_push(&co));
+    try std.testing.expectEqualSlices(u8, &[_]u8{ 3, 1, 2, 3, 1, 4, 0, 0 }, mock.tx[1][0..mock.tx_len[1]]);
+    c.nrf24_decoalesce_begin(&it, &mock.tx[1], mock.tx_len[1]);
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_decoalesce_next(&it, &msg, &len));
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_decoalesce_next(&it, &msg, &len));
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_decoalesce_next(&it, &msg, &len));
+
+    // Case 4: a frame without room for another message is written at once
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_coalesce_put(&co, &a, 3, 10));
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_coalesce_put(&co, &a, 3, 10));
+    try std.testing.expectEqual(@as(u8, 3), mock.tx_n);
+    try std.testing.expectEqual(@as(u32, 1), co.stats.full_flushes);
+
+    // Case 5: TX FIFO full, the frame is kept and the message not taken
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_coalesce_put(&co, &a, 3, 10));
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_coalesce_put(&co, &a, 3, 10));
+    try std.testing.expectEqual(@as(c_int, c.NRF24_ERR_BUSY), c.nrf24_coalesce_put(&co, &b, 1, 10));
+    try std.testing.expectEqual(@as(u8, 2), c.nrf24_coalesce_pending(&co));
+    try std.testing.expectEqual(@as(u32, 2), co.stats.busy);
+    mock.txSent();
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_coalesce_poll(&co, 10));
+    try std.testing.expectEqual(@as(u8, 1), mock.tx_n);
+    try std.testing.expectEqual(@as(u8, 0), c.nrf24_coalesce_pending(&co));
+
+    // Case 6: malformed packet, a length runs past the end
+    const bad = [_]u8{ 2, 1, 9, 9 };
+    c.nrf24_decoalesce_begin(&it, &bad, bad.len);
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_decoalesce_next(&it, &msg, &len));
+    try std.testing.expectEqual(@as(c_int, -1), c.nrf24_decoalesce_next(&it, &msg, &len));
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_decoalesce_next(&it, &msg, &len));
+
+    std.debug.print("c.nrf24_coalesce [\x1b[32mok\x1b[0m]\n", .{});
+}
+
+const RpcResult = struct {
+    n: usize = 0,
+    status: u8 = 0,
+    data: [32]u8 = undefined,
+    len: u8 = 0,
+
+    fn done(cl: [*c]c.nrf24_rpc_client_t, user: ?*anyopaque, status: u8, data: [*c]const u8, len: u8) callconv(.c) void {
+        const self: *RpcResult = @ptrCast(@alignCast(user.?));
+        _ = cl;
+        self.n += 1;
+        self.status = status;
+        self.len = len;
+        if (len > 0) {
+            @memcpy(self.data[0..len], data[0..len]);
+        }
+    }
+};
+
+test "c.nrf24_rpc_client" {
+    var mock = Mock{};
+    var nrf24: c.nrf24_t = undefined;
+    var cl: c.nrf24_rpc_client_t = undefined;
+    var calls: [2]c.nrf24_rpc_call_t = undefined;
+    var r1 = RpcResult{};
+    var r2 = RpcResult{};
+    const args = [_]u8{ 1, 2 };
+
+    try mock.attach(&nrf24);
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_rpc_client_init(&cl, &nrf24, &calls, 2));
+
+    // Case 1: requests are [id][method][args], ids count from 1
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_rpc_call(&cl, 7, &args, 2, 10, &RpcResult.done, &r1, 0));
+    try std.testing.expectEqual(@as(c_int, 2), c.nrf24_rpc_call(&cl, 8, null, 0, 50, &RpcResult.done, &r2, 0));
+    try std.testing.expectEqual(@as(c_int, c.NRF24_ERR_BUSY), c.nrf24_rpc_call(&cl, 9, null, 0, 50, &RpcResult.done, &r2, 0));
+    try std.testing.expectEqualSlices(u8, &[_]u8{ 1, 7, 1, 2 }, mock.tx[0][0..mock.tx_len[0]]);
+    try std.testing.expectEqualSlices(u8, &[_]u8{ 2, 8 }, mock.tx[1][0..mock.tx_len[1]]);
+
+    // Case 2: responses are matched by id, in any order; unknown ids are stale
+    mock.txSent();
+    mock.rxPush(&[_]u8{ 2, 0, 0xab }, 0);
+    mock.rxPush(&[_]u8{ 9, 0 }, 0);
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_rpc_client_poll(&cl, 1));
+    try std.testing.expectEqual(@as(usize, 1), r2.n);
+    try std.testing.expectEqual(@as(u8, c.NRF24_RPC_OK), r2.status);
+    try std.testing.expectEqualSlices(u8, &[_]u8{0xab}, r2.data[0..r2.len]);
+    try std.testing.expectEqual(@as(usize, 0), r1.n);
+    try std.testing.expectEqual(@as(u32, 1), cl.stats.stale);
+    try std.testing.expectEqual(@as(u8, 1), c.nrf24_rpc_outstanding(&cl));
+
+    // Case 3: a poll frame keeps the responses coming
+    try std.testing.expectEqualSlices(u8, &[_]u8{0}, mock.tx[0][0..mock.tx_len[0]]);
+    try std.testing.expectEqual(@as(u32, 1), cl.stats.polls);
+
+    // Case 4: call 1 times out at its deadline
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_rpc_client_poll(&cl, 9));
+    try std.testing.expectEqual(@as(usize, 0), r1.n);
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_rpc_client_poll(&cl, 10));
+    try std.testing.expectEqual(@as(usize, 1), r1.n);
+    try std.testing.expectEqual(@as(u8, c.NRF24_RPC_TIMEOUT), r1.status);
+    try std.testing.expectEqual(@as(u32, 1), cl.stats.timeouts);
+    try std.testing.expectEqual(@as(u8, 0), c.nrf24_rpc_outstanding(&cl));
+
+    // Case 5: its late response is stale, the id is not reused right away
+    mock.rxPush(&[_]u8{ 1, 0, 5 }, 0);
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_rpc_client_poll(&cl, 11));
+    try std.testing.expectEqual(@as(u32, 2), cl.stats.stale);
+    try std.testing.expectEqual(@as(usize, 1), r1.n);
+    mock.txSent();
+    try std.testing.expectEqual(@as(c_int, 3), c.nrf24_rpc_call(&cl, 7, &args, 2, 10, &RpcResult.done, &r1, 11));
+
+    std.debug.print("c.nrf24_rpc_client [\x1b[32mok\x1b[0m]\n", .{});
+}
+
+fn le16(buf: []const u8) u16 {
+    return std.mem.readInt(u16, buf[0..2], .little);
+}
+
+fn bulkWrite(ctx: ?*anyopaque, offset: u32, data: [*c]const u8, len: u8) callconv(.c) c_int {
+    _ = ctx;
+    _ = offset;
+    _ = data;
+    _ = len;
+    return 0;
+}
+
+fn bulkSave(ctx: ?*anyopaque, info: [*c]const c.nrf24_bulk_rx_info_t, bitmap: [*c]const u8, bytes: u16) callconv(.c) void {
+    _ = ctx;
+    _ = info;
+    _ = bitmap;
+    _ = bytes;
+}
+
+test "c.missing_ranges" {
+    var dummy = std.mem.zeroes(c.nrf24_t);
+    var rx: c.nrf24_bulk_rx_t = undefined;
+    var bitmap: [8]u8 = undefined;
+    var out: [4 * c.NRF24_BULK_RANGES]u8 = undefined;
+    var data = [_]u8{ 0x02, 0, 0, 0xaa }; // DATA [type][block LE16][data]
+
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_bulk_rx_init(&rx, &dummy, &bitmap, bitmap.len, &bulkWrite, &bulkSave, null));
+
+    // Case 1: START [type][id LE16][blocks LE16][size LE32], all blocks missing
+    const start = [_]u8{ 0x01, 0x34, 0x12, 40, 0, 0, 0, 0, 0 };
+    c.rx_start(&rx, &start, start.len);
+    try std.testing.expectEqual(@as(u16, 40), rx.info.blocks);
+    try std.testing.expectEqual(@as(u32, 1), rx.stats.saves);
+    try std.testing.expectEqual(@as(u8, 1), c.missing_ranges(&rx, &out));
+    try std.testing.expectEqual(@as(u16, 0), le16(out[0..]));
+    try std.testing.expectEqual(@as(u16, 40), le16(out[2..]));
+
+    // Case 2: holes at 3, 9..19 and 39
+    var block: u8 = 0;
+    while (block < 40) : (block += 1) {
+        if (block == 3 or (block >= 9 and block < 20) or block == 39) continue;
+        data[1] = block;
+        c.rx_data(&rx, &data, data.len);
+    }
+    try std.testing.expectEqual(@as(u8, 3), c.missing_ranges(&rx, &out));
+    try std.testing.expectEqual(@as(u16, 3), le16(out[0..]));
+    try std.testing.expectEqual(@as(u16, 1), le16(out[2..]));
+    try std.testing.expectEqual(@as(u16, 9), le16(out[4..]));
+    try std.testing.expectEqual(@as(u16, 11), le16(out[6..]));
+    try std.testing.expectEqual(@as(u16, 39), le16(out[8..]));
+    try std.testing.expectEqual(@as(u16, 1), le16(out[10..]));
+
+    // Case 3: a block received twice is a duplicate
+    data[1] = 3;
+    c.rx_data(&rx, &data, data.len);
+    c.rx_data(&rx, &data, data.len);
+    try std.testing.expectEqual(@as(u32, 1), rx.stats.duplicates);
+
+    // Case 4: resume a saved transfer with more holes than fit in one answer
+    var info = c.nrf24_bulk_rx_info_t{ .id = 7, .blocks = 64, .size = 64 * c.NRF24_BULK_BLOCK, .received = 0 };
+    @memset(&bitmap, 0x55);
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_bulk_rx_resume(&rx, &info));
+    try std.testing.expectEqual(@as(u8, c.NRF24_BULK_RANGES), c.missing_ranges(&rx, &out));
+    try std.testing.expectEqual(@as(u16, 1), le16(out[0..]));
+    try std.testing.expectEqual(@as(u16, 1), le16(out[2..]));
+    try std.testing.expectEqual(@as(u16, 13), le16(out[4 * 6 ..]));
+
+    // Case 5: START of the same transfer keeps the bitmap
+    var restart = [_]u8{ 0x01, 7, 0, 64, 0, 0x40, 0x07, 0, 0 };
+    c.rx_start(&rx, &restart, restart.len);
+    try std.testing.expectEqual(@as(u8, 0x55), bitmap[0]);
+    try std.testing.expectEqual(@as(u8, c.NRF24_BULK_RANGES), c.missing_ranges(&rx, &out));
+
+    // Case 6: a different transfer starts over
+    restart[1] = 8;
+    c.rx_start(&rx, &restart, restart.len);
+    try std.testing.expectEqual(@as(u8, 0), bitmap[0]);
+    try std.testing.expectEqual(@as(u8, 1), c.missing_ranges(&rx, &out));
+    try std.testing.expectEqual(@as(u16, 64), le16(out[2..]));
+
+    // Case 7: nothing missing once complete
+    block = 0;
+    while (block < 64) : (block += 1) {
+        data[1] = block;
+        c.rx_data(&rx, &data, data.len);
+    }
+    try std.testing.expectEqual(@as(u8, 0), c.missing_ranges(&rx, &out));
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_bulk_rx_is_complete(&rx));
+
+    // Case 8: a transfer larger than the bitmap is rejected
+    const large = [_]u8{ 0x01, 9, 0, 65, 0, 0, 0, 0, 0 };
+    c.rx_start(&rx, &large, large.len);
+    try std.testing.expectEqual(@as(u8, 1), rx.is_rejected);
+    try std.testing.expectEqual(@as(u16, 0), rx.info.blocks);
+    info.blocks = 65;
+    try std.testing.expectEqual(@as(c_int, -128), c.nrf24_bulk_rx_resume(&rx, &info));
+
+    std.debug.print("c.missing_ranges [\x1b[32mok\x1b[0m]\n", .{});
+}
+
+test "c.nrf24_credit_tx_credits" {
+    var dummy = std.mem.zeroes(c.nrf24_t);
+    var tx: c.nrf24_credit_tx_t = undefined;
+
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_credit_tx_init(&tx, &dummy, 4));
+    try std.testing.expectEqual(@as(c_int, 4), c.nrf24_credit_tx_credits(&tx));
+
+    // Case 1: frames sent use up credit
+    tx.sent = 3;
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_credit_tx_credits(&tx));
+
+    // Case 2: advert [0xC5][rx_count LE16][free]
+    c.tx_advert(&tx, &[_]u8{ 0xc5, 2, 0, 6 }, 4);
+    try std.testing.expectEqual(@as(c_int, 5), c.nrf24_credit_tx_credits(&tx));
+    try std.testing.expectEqual(@as(u32, 1), tx.stats.adverts);
+
+    // Case 3: a stale advert may leave credit negative
+    c.tx_advert(&tx, &[_]u8{ 0xc5, 1, 0, 0 }, 4);
+    try std.testing.expectEqual(@as(c_int, -2), c.nrf24_credit_tx_credits(&tx));
+    try std.testing.expectEqual(@as(u32, 0), tx.stats.resyncs);
+
+    // Case 4: short frames and other types are ignored
+    c.tx_advert(&tx, &[_]u8{ 0xc5, 2, 0, 6 }, 3);
+    c.tx_advert(&tx, &[_]u8{ 0x00, 2, 0, 6 }, 4);
+    try std.testing.expectEqual(@as(u32, 2), tx.stats.adverts);
+
+    // Case 5: counters wrap at 16 bits
+    tx.sent = 2;
+    c.tx_advert(&tx, &[_]u8{ 0xc5, 0xfe, 0xff, 3 }, 4);
+    try std.testing.expectEqual(@as(c_int, -1), c.nrf24_credit_tx_credits(&tx));
+    try std.testing.expectEqual(@as(u32, 0), tx.stats.resyncs);
+
+    // Case 6: more in flight than possible (receiver restarted): resync
+    tx.sent = 500;
+    c.tx_advert(&tx, &[_]u8{ 0xc5, 0, 0, 8 }, 4);
+    try std.testing.expectEqual(@as(u32, 1), tx.stats.resyncs);
+    try std.testing.expectEqual(@as(u16, 0), tx.sent);
+    try std.testing.expectEqual(@as(c_int, 8), c.nrf24_credit_tx_credits(&tx));
+
+    std.debug.print("c.nrf24_credit_tx_credits [\x1b[32mok\x1b[0m]\n", .{});
+}
+
+test "c.nrf24_backoff" {
+    var bo: c.nrf24_backoff_t = undefined;
+    const addr = [_]u8{ 0xc2, 0xc2, 0xc2, 0xc2, 0xc2 };
+
+    // Case 1: the seed depends on the whole address
+    try std.testing.expect(c.nrf24_backoff_seed(&addr, 5) != c.nrf24_backoff_seed(&addr, 4));
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_backoff_init(&bo, c.nrf24_backoff_seed(&addr, 5)));
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_backoff_may_tx(&bo, 0));
+
+    // Case 2: the window doubles per failure up to max_exp, wait in [slot, slot << exp)
+    var i: u8 = 1;
+    while (i <= 10) : (i += 1) {
+        const exp: u5 = @intCast(@min(i, 8));
+        const wait = c.nrf24_backoff_on_fail(&bo, 1000);
+        try std.testing.expectEqual(@as(u8, exp), bo.exp);
+        try std.testing.expect(wait >= 250 and wait < (@as(u32, 250) << exp));
+        try std.testing.expectEqual(@as(c_int, 0), c.nrf24_backoff_may_tx(&bo, 1000 + wait - 1));
+        try std.testing.expectEqual(@as(c_int, 1), c.nrf24_backoff_may_tx(&bo, 1000 + wait));
+        try std.testing.expectEqual(wait, c.nrf24_backoff_wait_us(&bo, 1000));
+        try std.testing.expectEqual(@as(u32, 0), c.nrf24_backoff_wait_us(&bo, 1000 + wait + 5));
+    }
+    try std.testing.expectEqual(@as(u32, 10), bo.stats.fails);
+    try std.testing.expectEqual(@as(u8, 8), bo.stats.max_exp_seen);
+
+    // Case 3: a clean success shrinks the window, a contended one keeps it
+    c.nrf24_backoff_on_success(&bo, 0);
+    try std.testing.expectEqual(@as(u8, 7), bo.exp);
+    c.nrf24_backoff_on_success(&bo, 2);
+    try std.testing.expectEqual(@as(u8, 7), bo.exp);
+    try std.testing.expectEqual(@as(u32, 1), bo.stats.contended);
+    try std.testing.expectEqual(@as(u32, 2), bo.stats.retries);
+
+    // Case 4: the us clock wraps
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_backoff_init(&bo, 0));
+    const wrap_wait = c.nrf24_backoff_on_fail(&bo, 0xffffff00);
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_backoff_may_tx(&bo, 0xffffff00));
+    try std.testing.expectEqual(@as(c_int, 1), c.nrf24_backoff_may_tx(&bo, 0xffffff00 +% wrap_wait));
+
+    std.debug.print("c.nrf24_backoff [\x1b[32mok\x1b[0m]\n", .{});
+}
+
+/// Fill the sync table with `num` samples `step_us` apart on a clock `ppb` fast, then fit
+fn tsyncFit(ts: *c.nrf24_tsync_t, t0: u32, ppb: i64, step_us: u32, num: u8) void {
+    var i: u8 = 0;
+    while (i < num) : (i += 1) {
+        const dl: i64 = @as(i64, i) * step_us;
+        ts.loc[i] = t0 +% @as(u32, @intCast(dl));
+        ts.off[i] = @bitCast(@as(i32, @intCast(123456 + @divTrunc(dl * ppb, 1000000000))));
+    }
+    ts.num = num;
+    c.fit(ts);
+}
+
+test "c.fit" {
+    var dummy = std.mem.zeroes(c.nrf24_t);
+    var ts: c.nrf24_tsync_t = undefined;
+
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_tsync_init(&ts, &dummy, 0));
+
+    // Case 1: 100 ppm, requests 30 s apart, across the local clock wrap
+    tsyncFit(&ts, 0xf0000000, 100000, 30000000, 8);
+    try std.testing.expect(@abs(ts.skew_ppb - 100000) <= 1);
+
+    // Case 2: 20 ppm, requests 60 s apart
+    tsyncFit(&ts, 5, 20000, 60000000, 8);
+    try std.testing.expect(@abs(ts.skew_ppb - 20000) <= 1);
+
+    // Case 3: slow clock, short spacing
+    tsyncFit(&ts, 5, -50000, 1000000, 8);
+    try std.testing.expectEqual(@as(i32, -50000), ts.skew_ppb);
+
+    // Case 4: the fit extrapolates one step past the table
+    const local: u32 = 5 + 8 * 60000000;
+    tsyncFit(&ts, 5, 20000, 60000000, 8);
+    const global = c.nrf24_tsync_global(&ts, local);
+    const want: u32 = local + 123456 + 8 * 60000000 / 50000;
+    try std.testing.expect(@abs(@as(i64, global) - want) <= 2);
+
+    std.debug.print("c.fit [\x1b[32mok\x1b[0m]\n", .{});
+}
+
+test "c.txn_merge" {
+    var cur = std.mem.zeroes(c.nrf24_regfile_t);
+    var txn = std.mem.zeroes(c.nrf24_cfg_txn_t);
+    var want: c.nrf24_regfile_t = undefined;
+    const addr = [_]u8{ 1, 2, 3, 4, 5 };
+
+    // staged on a powered-up PRX image
+    cur.regs[c.NRF24_REG_CONFIG] = 0x0f;
+    txn.regs = cur;
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_cfg_set_channel(&txn, 76));
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_cfg_set_crc(&txn, c.NRF24_CRC_1BYTE));
+    try std.testing.expectEqual(@as(c_int, 0), c.nrf24_cfg_set_tx_addr(&txn, &addr));
+
+    // Case 1: powered down and switched to PTX meanwhile, only the staged fields move
+    cur.regs[c.NRF24_REG_CONFIG] = 0x0c;
+    c.txn_merge(&txn, &cur, &want);
+    try std.testing.expectEqual(@as(u8, 0x08), want.regs[c.NRF24_REG_CONFIG]);
+    try std.testing.expectEqual(@as(u8, 76), want.regs[c.NRF24_REG_RF_CH]);
+    try std.testing.expectEqualSlices(u8, &addr, &want.tx_addr);
+    try std.testing.expectEqualSlices(u8, &cur.rx_addr_p0, &want.rx_addr_p0);
+
+    // Case 2: registers changed since begin and not staged are kept
+    cur.regs[c.NRF24_REG_SETUP_RETR] = 0x5f;
+    c.txn_merge(&txn, &cur, &want);
+    try std.testing.expectEqual(@as(u8, 0x5f), want.regs[c.NRF24_REG_SETUP_RETR]);
+    try std.testing.expectEqual(@as(c_int, 3), c.regfile_diff(&cur, &want));
+
+    std.debug.print("c.txn_merge [\x1b[32mok\x1b[0m]\n", .{});
+}
@@ -1021,6 +1021,67 @@ static void subcmd_perf_test_simplex(int argc, char **argv) {
     }
 }
 
+#ifdef NRF24L01_ENABLE_TRACE
+
+#ifndef NRF24_CMD_TRACE_RECS
+#define NRF24_CMD_TRACE_RECS 128
+#endif
+
+static nrf24_trace_t g_cmd_trace;
+static nrf24_trace_rec_t g_cmd_trace_recs[NRF24_CMD_TRACE_RECS];
+
+static void print_hex_stream(const void *data, int len) {
+    const uint8_t *p = (const uint8_t *)data;
+    for (int i = 0; i < len; i++) {
+        PRINT("%02x", p[i]);
+        if ((i & 0x1F) == 0x1F) {
+            PRINT("\n");
+        }
+    }
+}
+
+/**
+ * @note The dump is a plain hex stream, convert it with `xxd -r -p` and decode with `utils/tracedec`
+ */
+static void subcmd_trace(int argc, char **argv) {
+    if (argc != 1) {
+        PRINT("wrong arguments, check help for detail\n");
+        return;
+    }
+
+    if (strcmp(argv[0], "on") == 0) {
+        nrf24_trace_attach(g_cmd_nrf24, &g_cmd_trace, g_cmd_trace_recs, NRF24_CMD_TRACE_RECS);
+    } else if (strcmp(argv[0], "off") == 0) {
+        nrf24_trace_detach(g_cmd_nrf24);
+    } else if (strcmp(argv[0], "dump") == 0) {
+        nrf24_trace_hdr_t hdr;
+        nrf24_trace_t *trace = g_cmd_nrf24->dep.trace;
+
+        /* pause recording while dumping */
+        nrf24_trace_detach(g_cmd_nrf24);
+        int cnt = nrf24_trace_snapshot(&g_cmd_trace, &hdr, 0, 0);
+        print_hex_stream(&hdr, sizeof(hdr));
+        for (int i = 0; i < cnt; i++) {
+            nrf24_trace_rec_t rec;
+            /* copy out one by one (oldest first) to avoid a second buffer */
+            rec = g_cmd_trace.recs[(g_cmd_trace.seq - cnt + i) & g_cmd_trace.mask];
+            print_hex_stream(&rec, sizeof(rec));
+        }
+        PRINT("\n");
+        g_cmd_nrf24->dep.trace = trace;
+    } else {
+        PRINT("unknown action '%s'\n", argv[0]);
+    }
+}
+
+#define TRACE_SUBCMDS \
+    {"trace", subcmd_trace, "Record SPI transactions", \
+     "Usage: trace <on|off|dump>\n" \
+     "Note: decode the dump with `xxd -r -p dump.txt trace.bin && tracedec trace.bin`\n"},
+#else
+#define TRACE_SUBCMDS
+#endif // NRF24L01_ENABLE_TRACE
+
 static nrf24_subcmd_t g_subcmds[] = {
     {"help", subcmd_help, "Show command help", "Usage: help <cmd>\n"},
     {"reg", subcmd_access_reg, "Access register",
@@ -1058,6 +1119,7 @@ static nrf24_subcmd_t g_subcmds[] = {
      "Usage: pt-s [duration_s] [payload_size](1-32)\n"},
     {"pt-hd", subcmd_perf_test_halfduplex, "Do performance test (half-duplex)",
      "Usage: pt-hd [duration_s] [payload_size](1-32)\n"},
+    TRACE_SUBCMDS
     USER_SUBCMDS
     {NULL, NULL, NULL, NULL}};
 
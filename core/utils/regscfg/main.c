@@ -16,11 +16,134 @@ void print_l5arr(uint8_t *arr)
     printf("0x%02x%02x%02x%02x%02x\n", arr[4],arr[3],arr[2],arr[1],arr[0]);
 }
 
-int main(void)
+typedef struct {
+    uint8_t addr;
+    const char *name;
+    uint8_t val;
+} img_reg_t;
+
+#define IMG_REG(cfg, reg_name, field) { NRF24_REG_##reg_name, #reg_name, ASU8V(&(cfg)->field) }
+
+static void print_img_addr(const char *name, uint8_t *arr)
+{
+    printf("#define NRF24_REGIMAGE_%-12s 0x%02x, 0x%02x, 0x%02x, 0x%02x, 0x%02x /* LSB first */\n", name, arr[0], arr[1], arr[2], arr[3], arr[4]);
+}
+
+/**
+ * @brief Emit the image as runs of consecutive register addresses
+ *
+ * Runs are computed from the addresses in `regs` (sorted ascending), so adding
+ * or moving a register keeps the layout in sync.
+ */
+static void print_img_runs(const img_reg_t *regs, int num)
+{
+    int i = 0;
+
+    while (i < num) {
+        int n = 1;
+        while (i + n < num && regs[i + n].addr == regs[i + n - 1].addr + 1) {
+            n++;
+        }
+
+        printf("    NRF24_REG_%s, %d, \\\n", regs[i].name, n);
+        for (int k = 0; k < n; k++) {
+            printf("%sNRF24_REGIMAGE_%s,%s", (k % 4) == 0 ? "        " : " ", regs[i + k].name, (k % 4) == 3 || k == n - 1 ? " \\\n" : "");
+        }
+        i += n;
+    }
+}
+
+/**
+ * @brief Emit a ready-to-include header (core/src/nrf24l01_regimage.h)
+ *
+ * The image is a const byte stream of runs `{first_reg, num_regs, val...}`,
+ * so it stays in ROM and needs no per-register address byte.
+ */
+static void print_header(nrf24_regs_cfg_t *cfg)
+{
+    /* single-byte registers of the image, ascending addresses */
+    const img_reg_t regs[] = {
+        IMG_REG(cfg, CONFIG, config),
+        IMG_REG(cfg, EN_AA, en_aa),
+        IMG_REG(cfg, EN_RXADDR, en_rxaddr),
+        IMG_REG(cfg, SETUP_AW, setup_aw),
+        IMG_REG(cfg, SETUP_RETR, setup_retr),
+        IMG_REG(cfg, RF_CH, rf_ch),
+        IMG_REG(cfg, RF_SETUP, rf_setup),
+        IMG_REG(cfg, RX_ADDR_P2, rx_addr_p2),
+        IMG_REG(cfg, RX_ADDR_P3, rx_addr_p3),
+        IMG_REG(cfg, RX_ADDR_P4, rx_addr_p4),
+        IMG_REG(cfg, RX_ADDR_P5, rx_addr_p5),
+        IMG_REG(cfg, DYNPD, dynpd),
+        IMG_REG(cfg, FEATURE, feature),
+    };
+    const int num = sizeof(regs) / sizeof(regs[0]);
+
+    for (int i = 1; i < num; i++) {
+        if (regs[i].addr <= regs[i - 1].addr) {
+            fprintf(stderr, "register table not sorted at %s\n", regs[i].name);
+            return;
+        }
+    }
+
+    printf("/*\n");
+    printf(" * Register image (Gen by utils/regscfg: `./main --header`), do not edit by hand.\n");
+    printf(" *\n");
+    printf(" * Configuration:\n");
+    printf(" *  - PTX mode\n");
+    printf(" *  - Power down\n");
+    printf(" *  - channel %d\n", cfg->rf_ch.rf_ch);
+    printf(" *  - %d bytes crc\n", cfg->config.en_crc ? cfg->config.crco + 1 : 0);
+    printf(" *  - %d bytes address width\n", cfg->setup_aw.aw + 2);
+    printf(" *  - %d times retransmit && %dus delay\n", cfg->setup_retr.arc, (cfg->setup_retr.ard + 1) * 250);
+    printf(" */\n\n");
+
+    printf("#ifndef NRF24L01_REGIMAGE_H\n");
+    printf("#define NRF24L01_REGIMAGE_H\n\n");
+    printf("#include \"nrf24l01_reg.h\"\n\n");
+
+    for (int i = 0; i < num; i++) {
+        printf("#define NRF24_REGIMAGE_%-12s 0x%02x\n", regs[i].name, regs[i].val);
+    }
+    printf("\n/* Multi-byte addresses (not part of the image, they belong to the user config) */\n");
+    print_img_addr("RX_ADDR_P0", cfg->rx_addr_p0);
+    print_img_addr("RX_ADDR_P1", cfg->rx_addr_p1);
+    print_img_addr("TX_ADDR", cfg->tx_addr);
+
+    printf("\n/* Runs of consecutive single-byte registers: {first_reg, num_regs, val...}, terminated by NRF24_REGIMAGE_END */\n");
+    printf("#define NRF24_REGIMAGE_INITIALIZER { \\\n");
+    print_img_runs(regs, num);
+    printf("    NRF24_REGIMAGE_END }\n");
+
+    printf("\n/* Field range checks (keep hand edits of the values above valid) */\n");
+    printf("#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)\n");
+    printf("    _Static_assert((NRF24_REGIMAGE_CONFIG & 0x80) == 0, \"CONFIG: reserved bit must be 0\");\n");
+    printf("    _Static_assert((NRF24_REGIMAGE_CONFIG & REG_CONFIG_BITMASK_PWR_UP) == 0, \"CONFIG: image must keep the device powered down\");\n");
+    printf("    _Static_assert(NRF24_REGIMAGE_EN_AA == 0 || (NRF24_REGIMAGE_CONFIG & REG_CONFIG_BITMASK_EN_CRC), \"CONFIG: auto-ack requires CRC\");\n");
+    printf("    _Static_assert((NRF24_REGIMAGE_EN_AA & 0xC0) == 0, \"EN_AA: pipe 0~5 only\");\n");
+    printf("    _Static_assert((NRF24_REGIMAGE_EN_RXADDR & 0xC0) == 0, \"EN_RXADDR: pipe 0~5 only\");\n");
+    printf("    _Static_assert(NRF24_REGIMAGE_SETUP_AW >= 1 && NRF24_REGIMAGE_SETUP_AW <= 3, \"SETUP_AW: address width must be 3~5 bytes\");\n");
+    printf("    _Static_assert((NRF24_REGIMAGE_RF_CH & 0x80) == 0 && NRF24_REGIMAGE_RF_CH <= 125, \"RF_CH: channel must be 0~125\");\n");
+    printf("    _Static_assert((NRF24_REGIMAGE_RF_SETUP & 0x40) == 0, \"RF_SETUP: reserved bit must be 0\");\n");
+    printf("    _Static_assert((NRF24_REGIMAGE_RF_SETUP & 0x28) != 0x28, \"RF_SETUP: RF_DR_LOW and RF_DR_HIGH both set is reserved\");\n");
+    printf("    _Static_assert((NRF24_REGIMAGE_DYNPD & 0xC0) == 0, \"DYNPD: pipe 0~5 only\");\n");
+    printf("    _Static_assert(NRF24_REGIMAGE_DYNPD == 0 || (NRF24_REGIMAGE_FEATURE & REG_FEATURE_BITMASK_EN_DPL), \"DYNPD: requires FEATURE.EN_DPL\");\n");
+    printf("    _Static_assert((NRF24_REGIMAGE_FEATURE & 0xF8) == 0, \"FEATURE: reserved bits must be 0\");\n");
+    printf("#endif\n\n");
+
+    printf("#endif // NRF24L01_REGIMAGE_H\n");
+}
+
+int main(int argc, char **argv)
 {
     nrf24_regs_cfg_t cfg;
     nrf24_regscfg_init_default(&cfg);
 
+    if (argc > 1 && strcmp(argv[1], "--header") == 0) {
+        print_header(&cfg);
+        return 0;
+    }
+
     printf("addr, name, val\n");
 
     PRINT_REG(cfg, CONFIG, config);
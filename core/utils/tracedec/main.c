@@ -0,0 +1,182 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nrf24l01_reg.h"
+#include "nrf24l01_trace.h"
+#include "nrf24_reg_def.h"
+
+#define REG_NAME(reg) [NRF24_REG_##reg] = #reg
+
+static const char *g_reg_names[0x20] = {
+    REG_NAME(CONFIG),
+    REG_NAME(EN_AA),
+    REG_NAME(EN_RXADDR),
+    REG_NAME(SETUP_AW),
+    REG_NAME(SETUP_RETR),
+    REG_NAME(RF_CH),
+    REG_NAME(RF_SETUP),
+    REG_NAME(STATUS),
+    REG_NAME(OBSERVE_TX),
+    REG_NAME(RPD),
+    REG_NAME(RX_ADDR_P0),
+    REG_NAME(RX_ADDR_P1),
+    REG_NAME(RX_ADDR_P2),
+    REG_NAME(RX_ADDR_P3),
+    REG_NAME(RX_ADDR_P4),
+    REG_NAME(RX_ADDR_P5),
+    REG_NAME(TX_ADDR),
+    REG_NAME(RX_PW_P0),
+    REG_NAME(RX_PW_P1),
+    REG_NAME(RX_PW_P2),
+    REG_NAME(RX_PW_P3),
+    REG_NAME(RX_PW_P4),
+    REG_NAME(RX_PW_P5),
+    REG_NAME(FIFO_STATUS),
+    REG_NAME(DYNPD),
+    REG_NAME(FEATURE),
+};
+
+static const char *reg_name(uint8_t reg)
+{
+    return g_reg_names[reg & 0x1F] ? g_reg_names[reg & 0x1F] : "?";
+}
+
+static void format_cmd(const nrf24_trace_rec_t *rec, char *out, int size)
+{
+    uint8_t cmd = rec->cmd;
+
+    if (cmd == NRF24_TRACE_CMD_CE_LOW) {
+        snprintf(out, size, "CE=0");
+    } else if (cmd == NRF24_TRACE_CMD_CE_HIGH) {
+        snprintf(out, size, "CE=1");
+    } else if ((cmd & 0xE0) == NRF24_CMD_R_REG) {
+        snprintf(out, size, "R %s", reg_name(cmd));
+    } else if ((cmd & 0xE0) == NRF24_CMD_W_REG) {
+        snprintf(out, size, "W %s", reg_name(cmd));
+    } else if ((cmd & 0xF8) == NRF24_CMD_W_ACK_PAYLOAD) {
+        snprintf(out, size, "W_ACK_PAYLOAD(p%d)", cmd & 0x07);
+    } else {
+        switch (cmd) {
+        case NRF24_CMD_R_RX_PAYLOAD: snprintf(out, size, "R_RX_PAYLOAD"); break;
+        case NRF24_CMD_W_TX_PAYLOAD: snprintf(out, size, "W_TX_PAYLOAD"); break;
+        case NRF24_CMD_W_TX_PAYLOAD_NO_ACK: snprintf(out, size, "W_TX_PAYLOAD_NOACK"); break;
+        case NRF24_CMD_FLUSH_TX: snprintf(out, size, "FLUSH_TX"); break;
+        case NRF24_CMD_FLUSH_RX: snprintf(out, size, "FLUSH_RX"); break;
+        case NRF24_CMD_REUSE_TX_PL: snprintf(out, size, "REUSE_TX_PL"); break;
+        case NRF24_CMD_ACTIVATE: snprintf(out, size, "ACTIVATE"); break;
+        case NRF24_CMD_R_RX_PL_WID: snprintf(out, size, "R_RX_PL_WID"); break;
+        case NRF24_CMD_NOP: snprintf(out, size, "NOP"); break;
+        default: snprintf(out, size, "CMD 0x%02x", cmd); break;
+        }
+    }
+}
+
+static void format_status(uint8_t raw, char *out, int size)
+{
+    reg_status_t sta;
+
+    if (raw == NRF24_TRACE_STATUS_UNKNOWN) {
+        snprintf(out, size, "?");
+        return;
+    }
+
+    sta.raw = raw;
+
+    snprintf(out, size, "%s%s%s%s p%c",
+        sta.rx_dr ? "RX_DR " : "",
+        sta.tx_ds ? "TX_DS " : "",
+        sta.max_rt ? "MAX_RT " : "",
+        sta.tx_full ? "TX_FULL" : "",
+        sta.rx_p_no <= 5 ? '0' + sta.rx_p_no : '-');
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s <trace.bin> [-g gap_us]\n", prog);
+    fprintf(stderr, "    -g gap_us: highlight records more than gap_us after the previous one (default 1000)\n");
+}
+
+int main(int argc, char **argv)
+{
+    nrf24_trace_hdr_t hdr;
+    nrf24_trace_rec_t rec;
+    const char *path = 0;
+    double gap_us = 1000;
+    double t0 = 0, tprev = 0;
+    FILE *fp;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            gap_us = atof(argv[++i]);
+        } else if (path == 0) {
+            path = argv[i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (path == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    fp = fopen(path, "rb");
+    if (fp == 0) {
+        perror(path);
+        return 1;
+    }
+
+    if (fread(&hdr, sizeof(hdr), 1, fp) != 1
+        || hdr.magic[0] != NRF24_TRACE_MAGIC0 || hdr.magic[1] != NRF24_TRACE_MAGIC1) {
+        fprintf(stderr, "not a nrf24 trace dump\n");
+        fclose(fp);
+        return 1;
+    }
+
+    if (hdr.version != NRF24_TRACE_VERSION || hdr.rec_size != sizeof(rec) || hdr.ts_hz == 0) {
+        fprintf(stderr, "unsupported trace (version %d, record size %d, ts_hz %u)\n", hdr.version, hdr.rec_size, hdr.ts_hz);
+        fclose(fp);
+        return 1;
+    }
+
+    printf("records: %u (lost: %u), timestamp: %u Hz\n", hdr.count, hdr.lost, hdr.ts_hz);
+    printf("%12s %10s  %-22s %3s  %-14s %s\n", "time(us)", "delta(us)", "command", "len", "data", "status");
+
+    for (uint32_t i = 0; i < hdr.count; i++) {
+        char cmd[32];
+        char data[16] = {0};
+        char sta[32];
+        double t;
+        double delta;
+
+        if (fread(&rec, sizeof(rec), 1, fp) != 1) {
+            fprintf(stderr, "truncated dump (%u of %u records)\n", i, hdr.count);
+            break;
+        }
+
+        /* timestamps are 32-bit ticks, unsigned subtraction handles wrap-around */
+        if (i == 0) {
+            t0 = rec.ts;
+            t = 0;
+            delta = 0;
+        } else {
+            delta = (double)(uint32_t)(rec.ts - (uint32_t)tprev) * 1e6 / hdr.ts_hz;
+            t = (double)(uint32_t)(rec.ts - (uint32_t)t0) * 1e6 / hdr.ts_hz;
+        }
+        tprev = rec.ts;
+
+        format_cmd(&rec, cmd, sizeof(cmd));
+        format_status(rec.status, sta, sizeof(sta));
+        for (int k = 0; k < rec.len && k < NRF24_TRACE_DATA_MAX; k++) {
+            sprintf(data + k * 3, "%02x ", rec.data[k]);
+        }
+
+        printf("%12.1f %10.1f%s %-22s %3d  %-14s %s%s\n", t, delta,
+            delta > gap_us ? "!" : " ", cmd, rec.len, data, sta,
+            (rec.flags & NRF24_TRACE_FLAG_ERR) ? " [ERR]" : "");
+    }
+
+    fclose(fp);
+    return 0;
+}
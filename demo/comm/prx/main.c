@@ -3,51 +3,59 @@
 static void DEMONAME(void);
 
 #include "nrf24_demo_main.inc.c"
+#include "nrf24l01_loop.h"
 
 #define UTILIZE_ALL_FIFOS
 
-static void DEMONAME(void)
+static uint32_t g_txcnt = 0;
+
+static void port_wait(void *ctx, uint32_t timeout_ms)
+{
+    rt_thread_mdelay(timeout_ms);
+}
+
+static void fill_ack_payloads(nrf24_loop_t *loop)
 {
-    nrf24_setup(&g_nrf24, NRF24_ROLE_PRX); 
-    
-    uint8_t pipe;
-    uint8_t rxlen;
-    uint8_t rxbuf[33];
-    uint32_t txcnt = 0;
     uint8_t txbuf[32] = {0};
-    while (1)
-    {
+
 #ifdef UTILIZE_ALL_FIFOS
-        /* fill up the TX FIFO */
-        while (nrf24_txfifo_has_space(&g_nrf24))
-        {
-            txcnt++;
-            char actual_size = rt_snprintf(txbuf, sizeof(txbuf), "This is %s (%d)\n", DEMONAME_STR, txcnt);
-            nrf24_txfifo_write(&g_nrf24, txbuf, actual_size);
-        }
+    /* fill up the TX FIFO */
+    while (nrf24_txfifo_has_space(loop->nrf24))
 #else
-        if (nrf24_txfifo_is_empty(&g_nrf24))
-        {
-            txcnt++;
-            char actual_size = rt_snprintf(txbuf, sizeof(txbuf), "This is %s (%d)\n", DEMONAME_STR, txcnt);
-            nrf24_txfifo_write(&g_nrf24, txbuf, actual_size);
-        }
+    if (nrf24_txfifo_is_empty(loop->nrf24))
 #endif
-
-        int result =
-            nrf24_status_routine(&g_nrf24, nrf24_read_and_clear_status(&g_nrf24));
-        if (result == 0)
-        {
-            rt_thread_mdelay(5);
-            continue;
-        }
-
-        if (result & NRF24_STA_HAS_RXDATA)
-        {
-            uint8_t rxlen = 0;
-            nrf24_rxfifo_read(&g_nrf24, rxbuf, &rxlen, 0);
-            rxbuf[rxlen] = '\0';
-            rt_kprintf("rxdata (pipe %d) (%d bytes) : %s\n", pipe, rxlen, rxbuf);
-        }
+    {
+        g_txcnt++;
+        char actual_size = rt_snprintf(txbuf, sizeof(txbuf), "This is %s (%d)\n", DEMONAME_STR, g_txcnt);
+        nrf24_txfifo_write(loop->nrf24, txbuf, actual_size);
     }
 }
+
+static void on_rx(nrf24_loop_t *loop, const uint8_t *data, uint8_t len, uint8_t pipe)
+{
+    char rxbuf[33];
+
+    rt_memcpy(rxbuf, data, len);
+    rxbuf[len] = '\0';
+    rt_kprintf("rxdata (pipe %d) (%d bytes) : %s\n", pipe, len, rxbuf);
+
+    fill_ack_payloads(loop);
+}
+
+static void DEMONAME(void)
+{
+    static const nrf24_loop_cbs_t cbs = {
+        .on_rx = on_rx,
+        .on_idle = fill_ack_payloads,
+    };
+    static const nrf24_loop_port_t port = {
+        .wait = port_wait,
+    };
+    nrf24_loop_t loop;
+
+    nrf24_setup(&g_nrf24, NRF24_ROLE_PRX); 
+
+    /* poll every millisecond while idle */
+    nrf24_loop_init(&loop, &g_nrf24, NRF24_LOOP_POLL, &cbs, &port);
+    nrf24_loop_run(&loop);
+}
@@ -3,16 +3,66 @@
 static void DEMONAME(void);
 
 #include "nrf24_demo_main.inc.c"
+#include "nrf24l01_loop.h"
 
 #define UTILIZE_ALL_FIFOS
 
 #define NRF24_IRQ_PIN PKG_NRF24L01_DEMO_HAL_IRQ_PIN
 static rt_sem_t g_nrf24_irq_sem;
+static uint32_t g_txcnt = 0;
 
 static void nrf24_irq_handler(void *arg) { rt_sem_release(g_nrf24_irq_sem); }
 
+static void port_wait(void *ctx, uint32_t timeout_ms)
+{
+    rt_sem_take(g_nrf24_irq_sem, timeout_ms == NRF24_LOOP_WAIT_FOREVER ? RT_WAITING_FOREVER : rt_tick_from_millisecond(timeout_ms));
+}
+
+static uint32_t port_now_ms(void *ctx)
+{
+    return rt_tick_get_millisecond();
+}
+
+static void fill_ack_payloads(nrf24_loop_t *loop)
+{
+    uint8_t txbuf[32] = {0};
+
+#ifdef UTILIZE_ALL_FIFOS
+    /* fill up the TX FIFO */
+    while (nrf24_txfifo_has_space(loop->nrf24))
+#else
+    if (nrf24_txfifo_is_empty(loop->nrf24))
+#endif
+    {
+        g_txcnt++;
+        char actual_size = rt_snprintf(txbuf, sizeof(txbuf), "This is %s (%d)\n", DEMONAME_STR, g_txcnt);
+        nrf24_txfifo_write(loop->nrf24, txbuf, actual_size);
+    }
+}
+
+static void on_rx(nrf24_loop_t *loop, const uint8_t *data, uint8_t len, uint8_t pipe)
+{
+    char rxbuf[33];
+
+    rt_memcpy(rxbuf, data, len);
+    rxbuf[len] = '\0';
+    rt_kprintf("rxdata (pipe %d) (%d bytes) : %s\n", pipe, len, rxbuf);
+
+    fill_ack_payloads(loop);
+}
+
 static void DEMONAME(void)
 {
+    static const nrf24_loop_cbs_t cbs = {
+        .on_rx = on_rx,
+        .on_idle = fill_ack_payloads,
+    };
+    static const nrf24_loop_port_t port = {
+        .wait = port_wait,
+        .now_ms = port_now_ms,
+    };
+    nrf24_loop_t loop;
+
     int irqpin = rt_pin_get(NRF24_IRQ_PIN);
     rt_pin_mode(irqpin, PIN_MODE_INPUT_PULLUP);
     rt_pin_attach_irq(irqpin, PIN_IRQ_MODE_FALLING, nrf24_irq_handler, &g_nrf24);
@@ -20,47 +70,8 @@ static void DEMONAME(void)
     g_nrf24_irq_sem = rt_sem_create("nrf24irq", 0, RT_IPC_FLAG_FIFO);
 
     nrf24_setup(&g_nrf24, NRF24_ROLE_PRX); 
-    
-    uint8_t pipe;
-    uint8_t rxlen;
-    uint8_t rxbuf[33];
-    uint32_t txcnt = 0;
-    uint8_t txbuf[32] = {0};
-    while (1)
-    {
-#ifdef UTILIZE_ALL_FIFOS
-        /* fill up the TX FIFO */
-        while (nrf24_txfifo_has_space(&g_nrf24))
-        {
-            txcnt++;
-            char actual_size = rt_snprintf(txbuf, sizeof(txbuf), "This is %s (%d)\n", DEMONAME_STR, txcnt);
-            nrf24_txfifo_write(&g_nrf24, txbuf, actual_size);
-        }
-#else
-        if (nrf24_txfifo_is_empty(&g_nrf24))
-        {
-            txcnt++;
-            char actual_size = rt_snprintf(txbuf, sizeof(txbuf), "This is %s (%d)\n", DEMONAME_STR, txcnt);
-            nrf24_txfifo_write(&g_nrf24, txbuf, actual_size);
-        }
-#endif
-
 
-        /* Note: you can put `nrf24_read_and_clear_status(&g_nrf24)` in irq handler for faster response */
-        int result =
-            nrf24_status_routine(&g_nrf24, nrf24_read_and_clear_status(&g_nrf24));
-        if (result == 0)
-        {
-            rt_sem_take(g_nrf24_irq_sem, RT_WAITING_FOREVER);
-            continue;
-        }
-
-        if (result & NRF24_STA_HAS_RXDATA)
-        {
-            uint8_t rxlen = 0;
-            nrf24_rxfifo_read(&g_nrf24, rxbuf, &rxlen, 0);
-            rxbuf[rxlen] = '\0';
-            rt_kprintf("rxdata (pipe %d) (%d bytes) : %s\n", pipe, rxlen, rxbuf);
-        }
-    }
+    /* spin under load, block on the IRQ semaphore when idle */
+    nrf24_loop_init(&loop, &g_nrf24, NRF24_LOOP_HYBRID, &cbs, &port);
+    nrf24_loop_run(&loop);
 }
@@ -3,6 +3,7 @@
 static void DEMONAME(void);
 
 #include "nrf24_demo_main.inc.c"
+#include "nrf24l01_backoff.h"
 
 #define UTILIZE_ALL_FIFOS
 
@@ -10,6 +11,13 @@ static void DEMONAME(void)
 {
     nrf24_setup(&g_nrf24, NRF24_ROLE_PTX); 
 
+    /* back off randomly after MAX_RT, seeded by the node's own (pipe 1) address;
+       give every node a distinct one, or mix in the MCU unique id where available */
+    nrf24_backoff_t backoff;
+    nrf24_user_cfg_t ucfg;
+    nrf24_usercfg_read(&g_nrf24, &ucfg);
+    nrf24_backoff_init(&backoff, nrf24_backoff_seed(ucfg.rxpipes[1].addr, nrf24_addr_width(&g_nrf24)));
+
     uint8_t pipe;
     uint8_t rxlen;
     uint8_t rxbuf[33];
@@ -41,11 +49,13 @@ static void DEMONAME(void)
             continue;
         }
 
+        uint32_t now_us = rt_tick_get() * (1000000 / RT_TICK_PER_SECOND);
+        uint32_t wait_us = nrf24_backoff_event(&backoff, &g_nrf24, result, now_us);
         if (result == NRF24_STA_TX_FAIL)
         {
-            rt_kprintf("TX FAIL happen, suspend 1s\n");
-            rt_thread_mdelay(1000);
-            nrf24_clear_txfail_flag(&g_nrf24);
+            rt_kprintf("TX FAIL happen, back off %dus\n", wait_us);
+            rt_thread_mdelay(wait_us / 1000 + 1);
+            nrf24_backoff_resume(&backoff, &g_nrf24);
         }
 
         if (result & NRF24_STA_HAS_RXDATA)
@@ -3,6 +3,7 @@
 static void DEMONAME(void);
 
 #include "nrf24_demo_main.inc.c"
+#include "nrf24l01_backoff.h"
 
 #define NRF24_IRQ_PIN PKG_NRF24L01_DEMO_HAL_IRQ_PIN
 static rt_sem_t g_nrf24_irq_sem;
@@ -18,6 +19,13 @@ static void DEMONAME(void)
     g_nrf24_irq_sem = rt_sem_create("nrf24irq", 0, RT_IPC_FLAG_FIFO);
 
     nrf24_setup(&g_nrf24, NRF24_ROLE_PTX); 
+
+    /* back off randomly after MAX_RT, seeded by the node's own (pipe 1) address;
+       give every node a distinct one, or mix in the MCU unique id where available */
+    nrf24_backoff_t backoff;
+    nrf24_user_cfg_t ucfg;
+    nrf24_usercfg_read(&g_nrf24, &ucfg);
+    nrf24_backoff_init(&backoff, nrf24_backoff_seed(ucfg.rxpipes[1].addr, nrf24_addr_width(&g_nrf24)));
     
     uint8_t pipe;
     uint8_t rxlen;
@@ -43,6 +51,9 @@ static void DEMONAME(void)
             while(1) rt_thread_mdelay(1000);
         }
 
+        uint32_t now_us = rt_tick_get() * (1000000 / RT_TICK_PER_SECOND);
+        uint32_t wait_us = nrf24_backoff_event(&backoff, &g_nrf24, result, now_us);
+
         if (result & NRF24_STA_TX_SENT)
         {
             txcnt++;
@@ -52,9 +63,9 @@ static void DEMONAME(void)
 
         if (result == NRF24_STA_TX_FAIL)
         {
-            rt_kprintf("TX FAIL happen, suspend 1s\n");
-            rt_thread_mdelay(1000);
-            nrf24_clear_txfail_flag(&g_nrf24);
+            rt_kprintf("TX FAIL happen, back off %dus\n", wait_us);
+            rt_thread_mdelay(wait_us / 1000 + 1);
+            nrf24_backoff_resume(&backoff, &g_nrf24);
         }
         
         if (result & NRF24_STA_HAS_RXDATA)
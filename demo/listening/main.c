@@ -3,9 +3,32 @@
 static void DEMONAME(void);
 
 #include "nrf24_demo_main.inc.c"
+#include "nrf24l01_loop.h"
+
+static void port_wait(void *ctx, uint32_t timeout_ms)
+{
+    rt_thread_mdelay(timeout_ms);
+}
+
+static void on_rx(nrf24_loop_t *loop, const uint8_t *data, uint8_t len, uint8_t pipe)
+{
+    char buf[33];
+
+    rt_memcpy(buf, data, len);
+    buf[len] = '\0';
+    rt_kprintf("Listening: data from pipe %d: %s\n", pipe, buf);
+}
 
 static void DEMONAME(void)
 {
+    static const nrf24_loop_cbs_t cbs = {
+        .on_rx = on_rx,
+    };
+    static const nrf24_loop_port_t port = {
+        .wait = port_wait,
+    };
+    nrf24_loop_t loop;
+
     nrf24_user_cfg_t ucfg;
     nrf24_usercfg_init_default(&ucfg);
     ucfg.rxpipes[0].enable = 1; // enable pipe
@@ -13,16 +36,6 @@ static void DEMONAME(void)
     nrf24_setup_full(&g_nrf24, NRF24_ROLE_PRX, &ucfg, nrf24_default_regval_list, nrf24_default_regval_list_num); 
     
     /* Start */
-    uint8_t pipe;
-    uint8_t len;
-    uint8_t buf[33];
-    while(1) {
-        if (nrf24_rxfifo_has_data(&g_nrf24)) {
-            nrf24_rxfifo_read(&g_nrf24, buf, &len, &pipe);
-            buf[len] = '\0';
-            rt_kprintf("Listening: data from pipe %d: %s\n", pipe, buf);
-        }else {
-            rt_thread_mdelay(5);
-        }
-    }
+    nrf24_loop_init(&loop, &g_nrf24, NRF24_LOOP_POLL, &cbs, &port);
+    nrf24_loop_run(&loop);
 }
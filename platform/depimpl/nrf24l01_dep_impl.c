@@ -12,6 +12,10 @@ static int ops_init(void *ctx) {
     rt_pin_mode(p->ce_pin, PIN_MODE_OUTPUT);
     rt_pin_write(p->ce_pin, 0);
 
+#ifdef NRF24L01_ENABLE_LOCK
+    rt_mutex_init(&p->lock, "nrf24", RT_IPC_FLAG_PRIO);
+#endif
+
 #ifdef DEMIMPL_SUPPORT_GEN_SPIDEV
 
     if (p->need_gen_spidev)
@@ -67,7 +71,23 @@ static int ops_init(void *ctx) {
 static void ops_deinit(void *ctx) {
     struct nrf24_depimpl_ctx *p = (struct nrf24_depimpl_ctx *)ctx;
 
+#ifdef NRF24L01_ENABLE_LOCK
+    rt_mutex_detach(&p->lock);
+#endif
+}
+
+#ifdef NRF24L01_ENABLE_LOCK
+/* rt_mutex is recursive, as required by the driver */
+static void ops_lock(void *ctx) {
+    struct nrf24_depimpl_ctx *p = (struct nrf24_depimpl_ctx *)ctx;
+    rt_mutex_take(&p->lock, RT_WAITING_FOREVER);
+}
+
+static void ops_unlock(void *ctx) {
+    struct nrf24_depimpl_ctx *p = (struct nrf24_depimpl_ctx *)ctx;
+    rt_mutex_release(&p->lock);
 }
+#endif
 
 static void ops_set_ce_high(void *ctx) {
     struct nrf24_depimpl_ctx *p = (struct nrf24_depimpl_ctx *)ctx;
@@ -116,6 +136,10 @@ static nrf24_dep_ops_t g_nrf24_depimpl_ops = {
     .spi_send_then_recv = ops_spi_send_then_recv,
     .set_ce_high = ops_set_ce_high,
     .set_ce_low = ops_set_ce_low,
+#ifdef NRF24L01_ENABLE_LOCK
+    .lock = ops_lock,
+    .unlock = ops_unlock,
+#endif
 };
 
 nrf24_dep_ops_t *nrf24_depimpl_get_ops(void)  
@@ -146,3 +170,41 @@ void nrf24_depimpl_init_ctx_with_spidev(struct nrf24_depimpl_ctx *ctx, char *spi
     ctx->ce_pin = ce_pin;
     ctx->spi_dev_handle = RT_NULL;
 }
+
+#if defined(NRF24L01_ENABLE_TIMESTAMP) && ((defined(__ARM_ARCH_PROFILE) && __ARM_ARCH_PROFILE == 'M') || defined(__ARM_PROFILE_M__))
+
+#define SYST_RVR   (*(volatile uint32_t *)0xE000E014u)
+#define SYST_CVR   (*(volatile uint32_t *)0xE000E018u)
+#define SCB_ICSR   (*(volatile uint32_t *)0xE000ED04u)
+#define ICSR_PENDSTSET (1u << 26)
+
+/**
+ * @brief Free-running us counter: OS tick plus the elapsed part of the SysTick period.
+ *
+ * Assumes SysTick drives the RT-Thread tick (the Cortex-M BSP default). ISR-safe: a
+ * reload whose interrupt is still pending (caller above the SysTick priority) is counted.
+ */
+uint32_t nrf24_depimpl_time_us(void)
+{
+    uint32_t tick;
+    uint32_t load;
+    uint32_t val;
+    uint32_t pend;
+
+    do {
+        tick = rt_tick_get();
+        load = SYST_RVR;
+        val = SYST_CVR;
+        pend = SCB_ICSR & ICSR_PENDSTSET;
+    } while (tick != rt_tick_get());
+
+    // counter reloaded but its interrupt not served yet (`val` near `load`: read after the reload)
+    if (pend && val > load / 2) {
+        tick++;
+    }
+
+    return tick * (1000000 / RT_TICK_PER_SECOND)
+           + (uint32_t)((uint64_t)(load - val) * (1000000 / RT_TICK_PER_SECOND) / (load + 1));
+}
+
+#endif
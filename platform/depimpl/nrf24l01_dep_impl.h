@@ -11,6 +11,9 @@ struct nrf24_depimpl_ctx {
     char *spi_dev_name;
     struct rt_spi_device *spi_dev_handle;
     int ce_pin;
+#ifdef NRF24L01_ENABLE_LOCK
+    struct rt_mutex lock;
+#endif
 };
 
 void nrf24_depimpl_init_ctx(struct nrf24_depimpl_ctx *ctx, char *spi_dev_name, int ce_pin, char *spi_bus, int cs_pin);
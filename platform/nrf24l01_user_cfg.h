@@ -7,4 +7,23 @@
 #define NRF24L01_LOG_MIN_OUTPUT_LEVEL 'I'
 
 /* declare using Si24R1 */
-// #define NRF24L01_Si24R1_DEVICE
\ No newline at end of file
+// #define NRF24L01_Si24R1_DEVICE
+
+/* SPI transaction trace timestamp (replace with a us/cycle counter for finer resolution) */
+#ifdef NRF24L01_ENABLE_TRACE
+#define NRF24L01_TRACE_TIMESTAMP() ((uint32_t)rt_tick_get())
+#define NRF24L01_TRACE_TIMESTAMP_HZ RT_TICK_PER_SECOND
+#endif
+
+/* Event timestamp source in us
+ * Cortex-M: OS tick plus the SysTick down-counter (see depimpl), other targets must
+ * provide a us counter here; the OS tick alone is too coarse for time sync.
+ * One stamp is taken per RX_DR event, packets read under the same RX_DR share it. */
+#ifdef NRF24L01_ENABLE_TIMESTAMP
+#if (defined(__ARM_ARCH_PROFILE) && __ARM_ARCH_PROFILE == 'M') || defined(__ARM_PROFILE_M__)
+uint32_t nrf24_depimpl_time_us(void);
+#define NRF24L01_TIMESTAMP_US() nrf24_depimpl_time_us()
+#else
+#error "NRF24L01_ENABLE_TIMESTAMP: define NRF24L01_TIMESTAMP_US() with a us counter for this target"
+#endif
+#endif